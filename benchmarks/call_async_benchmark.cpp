@@ -0,0 +1,72 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+// Queues 1M functions by call_async() from 4 worker threads,
+// prints throughput and statistics of the queue.
+
+#include <boost/ui.hpp>
+
+#include <wx/app.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace ui = boost::ui;
+
+namespace {
+
+const int threads_count = 4;
+const int calls_count = 250 * 1000;
+
+int g_handled = 0;
+
+void handler()
+{
+    ++g_handled;
+}
+
+int ui_main()
+{
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for ( int i = 0; i < threads_count; i++ )
+        threads.push_back(std::thread([]
+        {
+            for ( int j = 0; j < calls_count; j++ )
+                ui::call_async(&handler);
+        }));
+
+    while ( g_handled < threads_count * calls_count )
+        wxTheApp->Yield(true);
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    for ( std::size_t i = 0; i < threads.size(); i++ )
+        threads[i].join();
+
+    const ui::async_queue_stats stats = ui::async_stats();
+    std::cout << "call_async(): " << g_handled / seconds / 1e6 << " M calls/s, "
+              << seconds * 1e9 / g_handled << " ns/call" << std::endl
+              << "Batches: " << stats.batches
+              << ", calls per batch: " << double(stats.calls) / stats.batches
+              << ", max depth: " << stats.max_depth << std::endl
+              << "Drain time, us: p50 " << stats.drain_time.value_at_percentile(50)
+              << ", p99 " << stats.drain_time.value_at_percentile(99)
+              << ", max " << stats.drain_time.max_value() << std::endl;
+
+    return 0;
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    return ui::entry(&ui_main, argc, argv);
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+// Dispatches 10M mouse move events to various handlers
+// and prints count of events per second of each way.
+
+#include <boost/ui.hpp>
+#include <boost/ui/native/event.hpp>
+#include <boost/ui/native/widget.hpp>
+
+#include <wx/window.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace ui = boost::ui;
+
+namespace {
+
+const int events_count = 10 * 1000 * 1000;
+
+int g_handled = 0;
+
+void handler()
+{
+    ++g_handled;
+}
+
+void handler_event(ui::mouse_event& e)
+{
+    g_handled += e.x() >= 0;
+}
+
+template <class F>
+void measure(const char* name, ui::widget& parent, F connect)
+{
+    ui::panel p(parent);
+    connect(p);
+
+    wxWindow* window = ui::native::from_widget(p);
+    wxMouseEvent wxevent(wxEVT_MOTION);
+    wxevent.SetEventObject(window);
+
+    g_handled = 0;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < events_count; i++ )
+        window->GetEventHandler()->ProcessEvent(wxevent);
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << name << ": " << events_count / seconds / 1e6 << " M events/s, "
+              << seconds * 1e9 / events_count << " ns/event"
+              << " (" << g_handled << " handled)" << std::endl;
+}
+
+void connect_native(ui::widget& w)
+{
+    ui::native::from_widget(w)->Bind(wxEVT_MOTION,
+        [](wxMouseEvent& e) { e.Skip(); handler(); });
+}
+
+// Handler is stored as its own type inside the native functor
+void connect_bind_helper(ui::widget& w)
+{
+    ui::native::bind_helper(w, wxEVT_MOTION, &handler);
+}
+
+void connect_mouse_move(ui::widget& w)
+{
+    w.on_mouse_move(&handler);
+}
+
+void connect_mouse_move_event(ui::widget& w)
+{
+    w.on_mouse_move_event(&handler_event);
+}
+
+void connect_mouse_drag(ui::widget& w)
+{
+    // Filtered out because buttons aren't pressed
+    w.on_mouse_drag(&handler);
+}
+
+int ui_main()
+{
+    ui::dialog dlg("Event benchmark");
+
+    measure("wxWidgets lambda", dlg, connect_native);
+    measure("native::bind_helper()", dlg, connect_bind_helper);
+    measure("widget::on_mouse_move()", dlg, connect_mouse_move);
+    measure("widget::on_mouse_move_event()", dlg, connect_mouse_move_event);
+    measure("widget::on_mouse_drag() with filter", dlg, connect_mouse_drag);
+
+    return 0;
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    return ui::entry(&ui_main, argc, argv);
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+// Measures overhead of event processing per event:
+// dispatching without handlers, through the application exception guard
+// into an empty handler, and through the queue of pending events.
+
+#include <boost/ui.hpp>
+#include <boost/ui/native/widget.hpp>
+
+#include <wx/app.h>
+#include <wx/window.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace ui = boost::ui;
+
+namespace {
+
+const int events_count = 1000 * 1000;
+
+int g_handled = 0;
+
+void on_event(wxCommandEvent&)
+{
+    ++g_handled;
+}
+
+template <class F>
+void measure(const char* name, F f)
+{
+    g_handled = 0;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    f();
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << name << ": " << seconds * 1e9 / events_count << " ns/event"
+              << " (" << g_handled << " handled)" << std::endl;
+}
+
+wxEvtHandler* g_handler = NULL;
+
+void process_unhandled()
+{
+    wxCommandEvent e(wxEVT_BUTTON);
+    for ( int i = 0; i < events_count; i++ )
+        g_handler->ProcessEvent(e);
+}
+
+// Each handler call passes through wxApp::CallEventHandler()
+void process_handled()
+{
+    wxCommandEvent e(wxEVT_MENU);
+    for ( int i = 0; i < events_count; i++ )
+        g_handler->ProcessEvent(e);
+}
+
+void process_pending()
+{
+    for ( int i = 0; i < events_count; i++ )
+        g_handler->QueueEvent(new wxCommandEvent(wxEVT_MENU));
+    wxTheApp->ProcessPendingEvents();
+}
+
+int ui_main()
+{
+    ui::dialog dlg("Event loop benchmark");
+    ui::panel p(dlg);
+
+    wxWindow* window = ui::native::from_widget(p);
+    window->Bind(wxEVT_MENU, &on_event);
+    g_handler = window->GetEventHandler();
+
+    measure("Event without handlers", process_unhandled);
+    measure("Event with handler", process_handled);
+    measure("Queued event with handler", process_pending);
+
+    return 0;
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    return ui::entry(&ui_main, argc, argv);
+}
@@ -0,0 +1,219 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+// Sends 200K messages of 64 bytes through a socket pair and compares
+// receiving them in the UI thread with fd_watcher against the reader thread
+// that passes each message to the UI thread with call_async().
+
+#include <boost/ui.hpp>
+
+#include <wx/app.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#ifndef BOOST_WINDOWS
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace ui = boost::ui;
+
+namespace {
+
+#ifndef BOOST_WINDOWS
+
+const int messages_count = 200 * 1000;
+const std::size_t message_size = 64;
+
+int g_handled = 0;
+unsigned g_checksum = 0;
+
+void on_message(const char* data)
+{
+    ++g_handled;
+    g_checksum += static_cast<unsigned char>(data[message_size - 1]);
+}
+
+void on_message_string(const std::string& message)
+{
+    on_message(message.data());
+}
+
+void write_messages(int fd)
+{
+    char message[message_size];
+    for ( int i = 0; i < messages_count; i++ )
+    {
+        for ( std::size_t j = 0; j < message_size; j++ )
+            message[j] = static_cast<char>(i + j);
+
+        std::size_t written = 0;
+        while ( written < message_size )
+        {
+            const ssize_t result = ::write(fd, message + written, message_size - written);
+            if ( result <= 0 )
+                return;
+            written += result;
+        }
+    }
+}
+
+// Splits stream into messages, keeps incomplete message in the buffer
+template <class Handler>
+class message_reader
+{
+public:
+    explicit message_reader(Handler handler) : m_handler(handler), m_size(0) {}
+
+    // Returns result of the last read() call
+    ssize_t read(int fd)
+    {
+        ssize_t result;
+        while ( (result = ::read(fd, m_buffer + m_size, sizeof(m_buffer) - m_size)) > 0 )
+        {
+            m_size += result;
+
+            std::size_t offset = 0;
+            for ( ; offset + message_size <= m_size; offset += message_size )
+                m_handler(m_buffer + offset);
+
+            std::copy(m_buffer + offset, m_buffer + m_size, m_buffer);
+            m_size -= offset;
+        }
+        return result;
+    }
+
+private:
+    Handler m_handler;
+    char m_buffer[64 * 1024];
+    std::size_t m_size;
+};
+
+void post_message(const char* data)
+{
+    ui::call_async(&on_message_string, std::string(data, message_size));
+}
+
+void wait_messages()
+{
+    while ( g_handled < messages_count )
+        wxTheApp->Yield(true);
+}
+
+double run_call_async(int fds[2])
+{
+    g_handled = 0;
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    std::thread reader([fds]
+    {
+        message_reader<void (*)(const char*)> r(&post_message);
+        r.read(fds[0]);
+    });
+    std::thread writer(&write_messages, fds[1]);
+
+    wait_messages();
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    writer.join();
+    ::shutdown(fds[1], SHUT_WR);
+    reader.join();
+
+    return seconds;
+}
+
+double run_fd_watcher(int fds[2])
+{
+    g_handled = 0;
+
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    message_reader<void (*)(const char*)> r(&on_message);
+    ui::fd_watcher watcher(fds[0]);
+    watcher.on_read([&]
+    {
+        r.read(fds[0]);
+    });
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    std::thread writer(&write_messages, fds[1]);
+
+    wait_messages();
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    writer.join();
+
+    return seconds;
+}
+
+void print(const char* name, double seconds)
+{
+    std::cout << name << ": " << messages_count / seconds / 1e6 << " M messages/s, "
+              << seconds * 1e9 / messages_count << " ns/message" << std::endl;
+}
+
+int ui_main()
+{
+    if ( !ui::fd_watcher::is_supported() )
+    {
+        std::cout << "fd_watcher isn't supported" << std::endl;
+        return 0;
+    }
+
+    int thread_fds[2];
+    int watcher_fds[2];
+    if ( ::socketpair(AF_UNIX, SOCK_STREAM, 0, thread_fds) != 0 ||
+         ::socketpair(AF_UNIX, SOCK_STREAM, 0, watcher_fds) != 0 )
+    {
+        std::cout << "Unable to create socket pair" << std::endl;
+        return 1;
+    }
+
+    const double thread_seconds  = run_call_async(thread_fds);
+    const double watcher_seconds = run_fd_watcher(watcher_fds);
+
+    print("Reader thread + call_async()", thread_seconds);
+    print("fd_watcher in the UI thread ", watcher_seconds);
+    std::cout << "Speedup: " << thread_seconds / watcher_seconds
+              << ", checksum: " << g_checksum << std::endl;
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        ::close(thread_fds[i]);
+        ::close(watcher_fds[i]);
+    }
+
+    return 0;
+}
+
+#else
+
+int ui_main()
+{
+    std::cout << "fd_watcher isn't supported" << std::endl;
+    return 0;
+}
+
+#endif
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    return ui::entry(&ui_main, argc, argv);
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+// Formats 10M doubles using various ways and prints time of each way.
+
+#include <boost/ui/string.hpp>
+#include <boost/ui/stream.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <stdio.h> // for snprintf()
+
+namespace ui = boost::ui;
+
+namespace {
+
+const std::size_t values_count = 10 * 1000 * 1000;
+
+template <class F>
+void measure(const char* name, const std::vector<double>& values, F f)
+{
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    const std::size_t length = f(values);
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << name << ": " << seconds << " s, "
+              << seconds * 1e9 / values.size() << " ns/value"
+              << " (" << length << " characters)" << std::endl;
+}
+
+// Previous implementation of to_uistring()
+std::size_t snprintf_ascii(const std::vector<double>& values)
+{
+    std::size_t length = 0;
+    for ( std::vector<double>::const_iterator iter = values.begin();
+          iter != values.end(); ++iter )
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof buffer, "%f", *iter);
+        length += ui::ascii(buffer).wstring().size();
+    }
+    return length;
+}
+
+std::size_t to_uistring(const std::vector<double>& values)
+{
+    std::size_t length = 0;
+    for ( std::vector<double>::const_iterator iter = values.begin();
+          iter != values.end(); ++iter )
+        length += ui::to_uistring(*iter).wstring().size();
+    return length;
+}
+
+std::size_t stream_shortest(const std::vector<double>& values)
+{
+    ui::uiostringstream ss;
+    for ( std::vector<double>::const_iterator iter = values.begin();
+          iter != values.end(); ++iter )
+        ss << *iter << '\n';
+    return ss.str().wstring().size();
+}
+
+std::size_t stream_fixed(const std::vector<double>& values)
+{
+    ui::uiostringstream ss;
+    ss.format(ui::chars_format::fixed).precision(6);
+    for ( std::vector<double>::const_iterator iter = values.begin();
+          iter != values.end(); ++iter )
+        ss << *iter << '\n';
+    return ss.str().wstring().size();
+}
+
+} // unnamed namespace
+
+int main()
+{
+    std::mt19937_64 engine(42);
+    std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+
+    std::vector<double> values(values_count);
+    for ( std::size_t i = 0; i < values.size(); i++ )
+        values[i] = distribution(engine);
+
+    measure("snprintf() + ascii()", values, snprintf_ascii);
+    measure("to_uistring()", values, to_uistring);
+    measure("uiostringstream, shortest", values, stream_shortest);
+    measure("uiostringstream, fixed", values, stream_fixed);
+
+    return 0;
+}
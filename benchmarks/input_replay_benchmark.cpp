@@ -0,0 +1,138 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+// Replays recorded input session and prints processing latency of events.
+// Usage: input_replay_benchmark [session.txt [speed]]
+// Without arguments records synthetic session of mouse moves, clicks and typing.
+// Speed 0 replays as fast as possible, 1 replays with original timing.
+
+#include <boost/ui.hpp>
+#include <boost/ui/native/widget.hpp>
+
+#include <wx/window.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace ui = boost::ui;
+
+namespace {
+
+int g_handled = 0;
+
+void handler()
+{
+    ++g_handled;
+}
+
+void process(wxWindow* window, wxEvent& e)
+{
+    e.SetEventObject(window);
+    window->GetEventHandler()->ProcessEvent(e);
+}
+
+// Sends native events to widgets while recording them
+std::string record_session(ui::text_box& tb, ui::panel& p)
+{
+    ui::input_recorder recorder;
+    recorder.start();
+
+    wxWindow* panel = ui::native::from_widget(p);
+    for ( int i = 0; i < 1000; i++ )
+    {
+        wxMouseEvent move(wxEVT_MOTION);
+        move.m_x = i % 200;
+        move.m_y = i / 5;
+        process(panel, move);
+
+        if ( i % 100 == 0 )
+        {
+            wxMouseEvent down(wxEVT_LEFT_DOWN);
+            process(panel, down);
+            wxMouseEvent up(wxEVT_LEFT_UP);
+            process(panel, up);
+        }
+    }
+
+    wxWindow* text = ui::native::from_widget(tb);
+    for ( int i = 0; i < 100; i++ )
+    {
+        wxKeyEvent key(wxEVT_CHAR);
+        key.m_keyCode = 'a' + i % 26;
+#if wxUSE_UNICODE
+        key.m_uniChar = key.m_keyCode;
+#endif
+        process(text, key);
+    }
+
+    recorder.stop();
+
+    std::ostringstream ss;
+    recorder.save(ss);
+    return ss.str();
+}
+
+int ui_main(int argc, char* argv[])
+{
+    ui::dialog dlg("Input replay benchmark");
+    ui::text_box tb(dlg);
+    ui::panel p(dlg);
+
+    p.on_mouse_move(&handler)
+     .on_left_mouse_down(&handler)
+     .on_left_mouse_up(&handler);
+    tb.on_key_press(&handler);
+
+    ui::vbox(dlg)
+        << tb.layout().justify()
+        << p.layout().stretch()
+        ;
+    dlg.show();
+
+    std::string session;
+    if ( argc > 1 )
+    {
+        std::ifstream file(argv[1]);
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        session = ss.str();
+    }
+    else
+        session = record_session(tb, p);
+
+    std::istringstream is(session);
+    ui::input_replayer replayer;
+    if ( !replayer.load(is) )
+    {
+        std::cerr << "Invalid session file" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    replayer.speed(argc > 2 ? std::atof(argv[2]) : 0);
+
+    g_handled = 0;
+    replayer.replay();
+
+    const ui::latency_histogram& latency = replayer.latency();
+    std::cout << "Replayed " << replayer.size() - replayer.missing_count()
+              << " of " << replayer.size() << " events"
+              << " (" << g_handled << " handled)" << std::endl
+              << "Latency, us: mean " << latency.mean()
+              << ", p50 " << latency.value_at_percentile(50)
+              << ", p90 " << latency.value_at_percentile(90)
+              << ", p99 " << latency.value_at_percentile(99)
+              << ", max " << latency.max_value() << std::endl;
+
+    return 0;
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    return ui::entry(&ui_main, argc, argv);
+}
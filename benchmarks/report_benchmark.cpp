@@ -0,0 +1,82 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+// Builds 100k-line report text using various ways and prints time of each way.
+
+#include <boost/ui/string.hpp>
+#include <boost/ui/stream.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace ui = boost::ui;
+
+namespace {
+
+const int lines_count = 100 * 1000;
+
+template <class F>
+void measure(const char* name, F f)
+{
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    const ui::uistring report = f();
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << name << ": " << seconds * 1e3 << " ms, "
+              << seconds * 1e9 / lines_count << " ns/line"
+              << " (" << report.wstring().size() << " characters)" << std::endl;
+}
+
+// Previous way: concatenation of temporary strings
+ui::uistring concatenation()
+{
+    ui::uistring report;
+    for ( int i = 0; i < lines_count; i++ )
+        report += ui::to_uistring(i) + L": value " +
+                  ui::to_uistring(i * 0.5) + L'\n';
+    return report;
+}
+
+ui::uistring stream()
+{
+    ui::uiostringstream ss;
+    for ( int i = 0; i < lines_count; i++ )
+        ss << i << L": value " << i * 0.5 << L'\n';
+    return ss.str();
+}
+
+ui::uistring stream_reserve_take()
+{
+    ui::uiostringstream ss;
+    ss.reserve(lines_count * 24);
+    for ( int i = 0; i < lines_count; i++ )
+        ss << i << L": value " << i * 0.5 << L'\n';
+    return ss.take();
+}
+
+ui::uistring stream_append_format()
+{
+    ui::uiostringstream ss;
+    ss.reserve(lines_count * 24);
+    for ( int i = 0; i < lines_count; i++ )
+        ss.append_format("{}: value {}\n", i, i * 0.5);
+    return ss.take();
+}
+
+} // unnamed namespace
+
+int main()
+{
+    measure("uistring concatenation", concatenation);
+    measure("uiostringstream", stream);
+    measure("uiostringstream, reserve() and take()", stream_reserve_take);
+    measure("uiostringstream::append_format()", stream_append_format);
+
+    return 0;
+}
@@ -299,6 +299,7 @@ private:
     void on_start();
     void on_next();
     void on_run();
+    void on_run_step();
     void on_close_handler(ui::close_event& e);
 
     void draw();
@@ -322,6 +323,7 @@ private:
 
     ui::canvas m_canvas;
     ui::event_loop m_loop;
+    ui::interval_handle m_run_interval;
 };
 
 sort_dialog::sort_dialog() : ui::dialog("Visualization of sorting algorithms"),
@@ -451,14 +453,21 @@ void sort_dialog::on_next()
 }
 
 void sort_dialog::on_run()
+{
+    if ( !m_run_interval.running() )
+    {
+        m_run_interval = ui::on_interval(chrono_ns::milliseconds(100),
+                                         &this_type::on_run_step, this);
+    }
+}
+
+void sort_dialog::on_run_step()
 {
     if ( m_loop.is_running() )
         m_loop.exit();
 
-    if ( !m_start_button.is_enabled() )
-    {
-        ui::on_timeout(chrono_ns::milliseconds(100), &this_type::on_run, this);
-    }
+    if ( m_start_button.is_enabled() )
+        m_run_interval.cancel();
 }
 
 void sort_dialog::on_close_handler(ui::close_event& e)
@@ -468,6 +477,8 @@ void sort_dialog::on_close_handler(ui::close_event& e)
         e.veto();
         ui::error_dialog("Unable to exit during algorithm execution");
     }
+    else
+        m_run_interval.cancel();
 }
 
 void sort_dialog::draw()
@@ -11,6 +11,7 @@
 #include <boost/ui/application.hpp>
 #include <boost/ui/audio.hpp>
 #include <boost/ui/button.hpp>
+#include <boost/ui/cancellation.hpp>
 #include <boost/ui/canvas.hpp>
 #include <boost/ui/check_box.hpp>
 #include <boost/ui/choice.hpp>
@@ -20,35 +21,46 @@
 #include <boost/ui/config.hpp>
 #include <boost/ui/coord.hpp>
 #include <boost/ui/coord_io.hpp>
+#include <boost/ui/coroutine.hpp>
 #include <boost/ui/datetime.hpp>
+#include <boost/ui/debounce.hpp>
 #include <boost/ui/def.hpp>
 #include <boost/ui/dialog.hpp>
 #include <boost/ui/event.hpp>
 #include <boost/ui/event_loop.hpp>
+#include <boost/ui/event_trace.hpp>
+#include <boost/ui/executor.hpp>
+#include <boost/ui/fd_watcher.hpp>
 #include <boost/ui/font.hpp>
 #include <boost/ui/frame.hpp>
 #include <boost/ui/group_box.hpp>
 #include <boost/ui/hyperlink.hpp>
+#include <boost/ui/idle.hpp>
 #include <boost/ui/image.hpp>
 #include <boost/ui/image_widget.hpp>
+#include <boost/ui/input_recorder.hpp>
+#include <boost/ui/interval.hpp>
 #include <boost/ui/label.hpp>
 #include <boost/ui/layout.hpp>
 #include <boost/ui/line.hpp>
 #include <boost/ui/list_box.hpp>
 #include <boost/ui/locale.hpp>
 #include <boost/ui/log.hpp>
+#include <boost/ui/log_view.hpp>
 #include <boost/ui/menu.hpp>
 #include <boost/ui/message.hpp>
 #include <boost/ui/notebook.hpp>
 #include <boost/ui/painter.hpp>
 #include <boost/ui/panel.hpp>
 #include <boost/ui/progress_bar.hpp>
+#include <boost/ui/remote.hpp>
 #include <boost/ui/slider.hpp>
 #include <boost/ui/status_bar.hpp>
 #include <boost/ui/stream.hpp>
 #include <boost/ui/string.hpp>
 #include <boost/ui/string_io.hpp>
 #include <boost/ui/strings_box.hpp>
+#include <boost/ui/text.hpp>
 #include <boost/ui/text_box.hpp>
 #include <boost/ui/thread.hpp>
 #include <boost/ui/web_widget.hpp>
@@ -208,6 +220,7 @@ Read README.md file for build instructions and library details.
 @example regex.cpp Boost.Regex and std::regex usage example
 @see <a href="http://en.wikipedia.org/wiki/Regular_expression">Regular expression (Wikipedia)</a>
 @example sort.cpp Visualization of sorting algorithms
+@see boost::ui::on_interval
 @see <a href="http://en.wikipedia.org/wiki/Sorting_algorithm">Sorting algorithm (Wikipedia)</a>
 @example spirit.cpp Boost.Spirit usage example
 @example thread.cpp Boost.Thread and std::thread usage example
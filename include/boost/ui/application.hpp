@@ -18,6 +18,7 @@
 #include <chrono>
 #endif
 
+#include <boost/cstdint.hpp>
 #include <boost/function.hpp>
 
 #ifdef BOOST_UI_USE_CHRONO
@@ -49,39 +50,68 @@ BOOST_UI_DECL int entry(int (*ui_main)(int, char*[]), int argc, char* argv[]);
 BOOST_UI_DECL int entry(int (*ui_main)(),             int argc, char* argv[]);
 ///@}
 
+/// @brief Handle of the function that was scheduled by on_timeout()
+/// @details Copies refer to the same function. Should be used in the UI thread.
+/// @ingroup event
+class BOOST_UI_DECL timeout_handle
+{
+public:
+    /// Constructs handle that doesn't refer to any function
+    timeout_handle() : m_id(0) {}
+
+    /// Cancels the function call, returns false if it was already called or cancelled
+    bool cancel();
+
+    /// Returns true if the function wasn't called or cancelled yet
+    bool pending() const;
+
+#ifndef DOXYGEN
+    explicit timeout_handle(boost::uint64_t id) : m_id(id) {}
+#endif
+
+private:
+    boost::uint64_t m_id;
+};
+
 #ifndef DOXYGEN
 
 namespace detail {
-BOOST_UI_DECL void on_timeout(int milliseconds, const boost::function<void()>& fn);
+BOOST_UI_DECL timeout_handle on_timeout(int milliseconds, const boost::function<void()>& fn);
+
+// Microseconds of monotonic clock, isn't changed by system time adjustments
+BOOST_UI_DECL boost::uint64_t monotonic_now();
+
+// Milliseconds of monotonic clock that on_timeout() uses
+BOOST_UI_DECL boost::uint64_t timeout_now();
 
 #ifndef BOOST_NO_CXX11_HDR_CHRONO
 template <class Rep, class Period>
-void on_timeout(const std::chrono::duration<Rep, Period>& d,
-                const boost::function<void()>& fn)
+timeout_handle on_timeout(const std::chrono::duration<Rep, Period>& d,
+                          const boost::function<void()>& fn)
 {
-    on_timeout(static_cast<int>(std::chrono::duration_cast<
-                    std::chrono::milliseconds>(d).count()),
-               fn);
+    return on_timeout(static_cast<int>(std::chrono::duration_cast<
+                           std::chrono::milliseconds>(d).count()),
+                      fn);
 }
 #endif
 
 #ifdef BOOST_UI_USE_CHRONO
 template <class Rep, class Period>
-void on_timeout(const boost::chrono::duration<Rep, Period>& d,
-                const boost::function<void()>& fn)
+timeout_handle on_timeout(const boost::chrono::duration<Rep, Period>& d,
+                          const boost::function<void()>& fn)
 {
-    on_timeout(static_cast<int>(boost::chrono::duration_cast<
-                    boost::chrono::milliseconds>(d).count()),
-               fn);
+    return on_timeout(static_cast<int>(boost::chrono::duration_cast<
+                           boost::chrono::milliseconds>(d).count()),
+                      fn);
 }
 #endif
 
 #ifdef BOOST_UI_USE_DATE_TIME
 template <class T, typename rep_type>
-void on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
-                const boost::function<void()>& fn)
+timeout_handle on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
+                          const boost::function<void()>& fn)
 {
-    on_timeout(static_cast<int>( td.total_milliseconds() ), fn);
+    return on_timeout(static_cast<int>( td.total_milliseconds() ), fn);
 }
 #endif
 
@@ -90,7 +120,8 @@ void on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
 #endif
 
 ///@{ @brief Calls function one time after the specified time duration
-/// @details
+/// @details Returns handle that can cancel the call.
+/// All timeouts share one native timer.
 /// Usage example:
 /// @snippet cpp11/snippet.cpp on_timeout
 /// @see BOOST_UI_USE_CHRONO
@@ -102,29 +133,29 @@ void on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
 #ifndef BOOST_NO_CXX11_HDR_CHRONO
 #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
 template <class Rep, class Period, class F, class ...Args>
-void on_timeout(const std::chrono::duration<Rep, Period>& d,
-                F&& f, Args&&... args)
+timeout_handle on_timeout(const std::chrono::duration<Rep, Period>& d,
+                          F&& f, Args&&... args)
 {
-    detail::on_timeout(d, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
+    return detail::on_timeout(d, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
 }
 #else
 template <class Rep, class Period>
-void on_timeout(const std::chrono::duration<Rep, Period>& d,
-                const boost::function<void()>& fn)
+timeout_handle on_timeout(const std::chrono::duration<Rep, Period>& d,
+                          const boost::function<void()>& fn)
 {
-    detail::on_timeout(d, fn);
+    return detail::on_timeout(d, fn);
 }
 template <class Rep, class Period, class F, class Arg1>
-void on_timeout(const std::chrono::duration<Rep, Period>& d,
-                F f, Arg1 a1)
+timeout_handle on_timeout(const std::chrono::duration<Rep, Period>& d,
+                          F f, Arg1 a1)
 {
-    detail::on_timeout(d, boost::bind(f, a1));
+    return detail::on_timeout(d, boost::bind(f, a1));
 }
 template <class Rep, class Period, class F, class Arg1, class Arg2>
-void on_timeout(const std::chrono::duration<Rep, Period>& d,
-                F f, Arg1 a1, Arg2 a2)
+timeout_handle on_timeout(const std::chrono::duration<Rep, Period>& d,
+                          F f, Arg1 a1, Arg2 a2)
 {
-    detail::on_timeout(d, boost::bind(f, a1, a2));
+    return detail::on_timeout(d, boost::bind(f, a1, a2));
 }
 #endif
 #endif
@@ -132,29 +163,29 @@ void on_timeout(const std::chrono::duration<Rep, Period>& d,
 #ifdef BOOST_UI_USE_CHRONO
 #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
 template <class Rep, class Period, class F, class ...Args>
-void on_timeout(const boost::chrono::duration<Rep, Period>& d,
-                F&& f, Args&&... args)
+timeout_handle on_timeout(const boost::chrono::duration<Rep, Period>& d,
+                          F&& f, Args&&... args)
 {
-    detail::on_timeout(d, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
+    return detail::on_timeout(d, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
 }
 #else
 template <class Rep, class Period>
-void on_timeout(const boost::chrono::duration<Rep, Period>& d,
-                const boost::function<void()>& fn)
+timeout_handle on_timeout(const boost::chrono::duration<Rep, Period>& d,
+                          const boost::function<void()>& fn)
 {
-    detail::on_timeout(d, fn);
+    return detail::on_timeout(d, fn);
 }
 template <class Rep, class Period, class F, class Arg1>
-void on_timeout(const boost::chrono::duration<Rep, Period>& d,
-                F f, Arg1 a1)
+timeout_handle on_timeout(const boost::chrono::duration<Rep, Period>& d,
+                          F f, Arg1 a1)
 {
-    detail::on_timeout(d, boost::bind(f, a1));
+    return detail::on_timeout(d, boost::bind(f, a1));
 }
 template <class Rep, class Period, class F, class Arg1, class Arg2>
-void on_timeout(const boost::chrono::duration<Rep, Period>& d,
-                F f, Arg1 a1, Arg2 a2)
+timeout_handle on_timeout(const boost::chrono::duration<Rep, Period>& d,
+                          F f, Arg1 a1, Arg2 a2)
 {
-    detail::on_timeout(d, boost::bind(f, a1, a2));
+    return detail::on_timeout(d, boost::bind(f, a1, a2));
 }
 #endif
 #endif
@@ -162,29 +193,29 @@ void on_timeout(const boost::chrono::duration<Rep, Period>& d,
 #ifdef BOOST_UI_USE_DATE_TIME
 #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
 template <class T, typename rep_type, class F, class ...Args>
-void on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
-                F&& f, Args&&... args)
+timeout_handle on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
+                          F&& f, Args&&... args)
 {
-    detail::on_timeout(td, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
+    return detail::on_timeout(td, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
 }
 #else
 template <class T, typename rep_type>
-void on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
-                const boost::function<void()>& fn)
+timeout_handle on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
+                          const boost::function<void()>& fn)
 {
-    detail::on_timeout(td, fn);
+    return detail::on_timeout(td, fn);
 }
 template <class T, typename rep_type, class F, class Arg1>
-void on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
-                F f, Arg1 a1)
+timeout_handle on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
+                          F f, Arg1 a1)
 {
-    detail::on_timeout(td, boost::bind(f, a1));
+    return detail::on_timeout(td, boost::bind(f, a1));
 }
 template <class T, typename rep_type, class F, class Arg1, class Arg2>
-void on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
-                F f, Arg1 a1, Arg2 a2)
+timeout_handle on_timeout(const boost::date_time::time_duration<T, rep_type>& td,
+                          F f, Arg1 a1, Arg2 a2)
 {
-    detail::on_timeout(td, boost::bind(f, a1, a2));
+    return detail::on_timeout(td, boost::bind(f, a1, a2));
 }
 #endif
 #endif
@@ -0,0 +1,64 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file cancellation.hpp Cancellation of background tasks
+
+#ifndef BOOST_UI_CANCELLATION_HPP
+#define BOOST_UI_CANCELLATION_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/shared_ptr.hpp>
+
+namespace boost {
+namespace ui    {
+
+class widget;
+
+/// @brief Thread-safe request to stop background task
+/// @details Copies of the token share the same state.
+/// Token that is bound to widget is cancelled when the native widget
+/// is destroyed, so background task doesn't update closed window.
+/// Usage example:
+/// @code
+/// ui::cancellation_token token(dlg);
+/// pool.post(token, [token]
+/// {
+///     while ( !token.cancelled() && step() )
+///         ;
+/// });
+/// @endcode
+/// @see thread_pool::post()
+/// @ingroup thread
+
+class BOOST_UI_DECL cancellation_token
+{
+public:
+    /// Creates token that isn't cancelled
+    cancellation_token();
+
+    /// @brief Creates token that is cancelled when @a owner widget is destroyed
+    /// @details Should be called from the UI thread
+    explicit cancellation_token(widget& owner);
+
+    /// Requests cancellation, can be called from any thread
+    void cancel();
+
+    /// Returns true if cancellation was requested, can be called from any thread
+    bool cancelled() const;
+
+private:
+    class impl;
+    boost::shared_ptr<impl> m_impl;
+};
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_CANCELLATION_HPP
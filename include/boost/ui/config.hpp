@@ -78,6 +78,10 @@
 
 #ifdef DOXYGEN
 
+/// @brief Enables Boost.Asio library
+/// @ingroup helper
+#define BOOST_UI_USE_ASIO
+
 /// @brief Enables Boost.Chrono library
 /// @ingroup helper
 #define BOOST_UI_USE_CHRONO
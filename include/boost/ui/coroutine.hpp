@@ -0,0 +1,320 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file coroutine.hpp C++20 coroutines support
+
+#ifndef BOOST_UI_COROUTINE_HPP
+#define BOOST_UI_COROUTINE_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if defined(DOXYGEN) || (defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L)
+
+#ifndef BOOST_UI_NO_COROUTINES
+#define BOOST_UI_HAS_COROUTINES
+#endif
+
+#endif
+
+#ifdef BOOST_UI_HAS_COROUTINES
+
+#include <boost/ui/application.hpp>
+#include <boost/ui/executor.hpp>
+#include <boost/ui/thread.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+
+namespace boost {
+namespace ui    {
+
+#ifndef DOXYGEN
+
+namespace detail {
+
+// Per-thread free lists of coroutine frames in 64 bytes size classes.
+// Frame can be freed by other thread, then it goes to that thread's list.
+class frame_pool
+{
+public:
+    static void* allocate(std::size_t size)
+    {
+        const std::size_t index = size_class(size);
+        if ( index < classes_count )
+        {
+            free_list& list = lists()[index];
+            if ( list.head )
+            {
+                block* b = list.head;
+                list.head = b->next;
+                list.count--;
+                return b;
+            }
+            return ::operator new((index + 1) * granularity);
+        }
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* p, std::size_t size) noexcept
+    {
+        const std::size_t index = size_class(size);
+        if ( index < classes_count )
+        {
+            free_list& list = lists()[index];
+            if ( list.count < max_cached )
+            {
+                block* b = static_cast<block*>(p);
+                b->next = list.head;
+                list.head = b;
+                list.count++;
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+private:
+    static const std::size_t granularity = 64;
+    static const std::size_t classes_count = 16;
+    static const std::size_t max_cached = 64;
+
+    struct block
+    {
+        block* next;
+    };
+
+    struct free_list
+    {
+        block* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    struct thread_lists
+    {
+        free_list lists[classes_count];
+
+        ~thread_lists()
+        {
+            for ( free_list& list : lists )
+                while ( list.head )
+                {
+                    block* b = list.head;
+                    list.head = b->next;
+                    ::operator delete(b);
+                }
+        }
+    };
+
+    static std::size_t size_class(std::size_t size)
+    {
+        return (size + granularity - 1) / granularity - 1;
+    }
+
+    static free_list* lists()
+    {
+        thread_local thread_lists instance;
+        return instance.lists;
+    }
+};
+
+// Resumes coroutine, fits into boost::function buffer without allocation
+class coroutine_resumer
+{
+public:
+    explicit coroutine_resumer(std::coroutine_handle<> handle) : m_handle(handle) {}
+
+    void operator()() const
+    {
+        m_handle.resume();
+    }
+
+private:
+    std::coroutine_handle<> m_handle;
+};
+
+} // namespace detail
+
+#endif
+
+/// @brief Return type of coroutine that starts immediately and isn't awaited
+/// @details Coroutine frames are allocated from per-thread pools.
+/// Exception that leaves coroutine is rethrown in the UI thread.
+/// Usage example:
+/// @code
+/// ui::task load(ui::thread_pool& pool, ui::list_box& list)
+/// {
+///     co_await ui::resume_on_pool(pool);
+///     std::vector<ui::uistring> lines = parse(read_file());
+///     co_await ui::resume_on_ui();
+///     list.assign(lines);
+/// }
+/// @endcode
+/// @ingroup thread
+
+class task
+{
+public:
+#ifndef DOXYGEN
+    struct promise_type
+    {
+        task get_return_object() noexcept { return task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+
+        void unhandled_exception()
+        {
+            const std::exception_ptr e = std::current_exception();
+            detail::call_async([e] { std::rethrow_exception(e); });
+        }
+
+        static void* operator new(std::size_t size)
+        {
+            return detail::frame_pool::allocate(size);
+        }
+
+        static void operator delete(void* p, std::size_t size) noexcept
+        {
+            detail::frame_pool::deallocate(p, size);
+        }
+    };
+#endif
+};
+
+#ifndef DOXYGEN
+
+namespace detail {
+
+// Queues itself without allocation because it lives in coroutine frame
+class ui_awaiter : private async_item
+{
+public:
+    bool await_ready() const noexcept
+    {
+        return is_ui_thread();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        m_handle = handle;
+        call = &ui_awaiter::resume;
+        next = nullptr;
+        call_async(static_cast<async_item*>(this));
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    static void resume(async_item* item)
+    {
+        static_cast<ui_awaiter*>(item)->m_handle.resume();
+    }
+
+    std::coroutine_handle<> m_handle;
+};
+
+class pool_awaiter
+{
+public:
+    explicit pool_awaiter(thread_pool& pool) : m_pool(pool) {}
+
+    bool await_ready() const
+    {
+        return m_pool.running_in_this_thread();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        m_pool.post(boost::function<void()>(coroutine_resumer(handle)));
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    thread_pool& m_pool;
+};
+
+class delay_awaiter
+{
+public:
+    explicit delay_awaiter(int milliseconds) : m_milliseconds(milliseconds) {}
+
+    bool await_ready() const noexcept
+    {
+        return m_milliseconds <= 0;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        on_timeout(m_milliseconds, boost::function<void()>(coroutine_resumer(handle)));
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    int m_milliseconds;
+};
+
+} // namespace detail
+
+#endif
+
+/// @brief Returns awaitable that resumes coroutine in the UI thread
+/// @details Doesn't suspend coroutine that already runs in the UI thread.
+/// Awaiting doesn't allocate memory.
+/// @ingroup thread
+inline
+#ifndef DOXYGEN
+detail::ui_awaiter
+#else
+unspecified
+#endif
+resume_on_ui()
+{
+    return {};
+}
+
+/// @brief Returns awaitable that resumes coroutine in one of threads of @a pool
+/// @details Doesn't suspend coroutine that already runs in @a pool
+/// @ingroup thread
+inline
+#ifndef DOXYGEN
+detail::pool_awaiter
+#else
+unspecified
+#endif
+resume_on_pool(thread_pool& pool)
+{
+    return detail::pool_awaiter(pool);
+}
+
+/// @brief Returns awaitable that resumes coroutine in the UI thread after @a d duration
+/// @details Should be awaited in the UI thread
+/// @ingroup thread
+template <class Rep, class Period>
+#ifndef DOXYGEN
+detail::delay_awaiter
+#else
+unspecified
+#endif
+delay(const std::chrono::duration<Rep, Period>& d)
+{
+    return detail::delay_awaiter(static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(d).count()));
+}
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_HAS_COROUTINES
+
+#endif // BOOST_UI_COROUTINE_HPP
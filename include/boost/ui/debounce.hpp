@@ -0,0 +1,297 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file debounce.hpp Debounce and throttle handler adapters
+
+#ifndef BOOST_UI_DEBOUNCE_HPP
+#define BOOST_UI_DEBOUNCE_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/application.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace boost {
+namespace ui    {
+
+#ifndef DOXYGEN
+
+namespace detail {
+
+// Timeout is scheduled once per series of calls on the shared timer wheel,
+// when it expires earlier than the last call allows it is scheduled again
+// for the rest of the time
+template <class F>
+class debounce_state : private boost::noncopyable
+{
+public:
+    debounce_state(int milliseconds, const F& f)
+        : m_milliseconds(milliseconds), m_fn(f), m_last_call(0),
+          m_rescheduling(false) {}
+
+    ~debounce_state()
+    {
+        m_timeout.cancel();
+    }
+
+    void call()
+    {
+        m_last_call = timeout_now();
+
+        if ( !m_timeout.pending() )
+            schedule(m_milliseconds);
+    }
+
+private:
+    void schedule(int milliseconds)
+    {
+        m_timeout = on_timeout(milliseconds, boost::bind(&debounce_state::fire, this));
+    }
+
+    void fire()
+    {
+        // Without native timers on_timeout() calls function immediately
+        const boost::uint64_t elapsed = timeout_now() - m_last_call;
+        if ( elapsed < static_cast<boost::uint64_t>(m_milliseconds) && !m_rescheduling )
+        {
+            m_rescheduling = true;
+            schedule(m_milliseconds - static_cast<int>(elapsed));
+            m_rescheduling = false;
+            return;
+        }
+
+        m_fn();
+    }
+
+    const int m_milliseconds;
+    F m_fn;
+    boost::uint64_t m_last_call;
+    bool m_rescheduling;
+    timeout_handle m_timeout;
+};
+
+template <class F>
+class throttle_state : private boost::noncopyable
+{
+public:
+    throttle_state(int milliseconds, const F& f)
+        : m_milliseconds(milliseconds), m_fn(f), m_pending(false) {}
+
+    ~throttle_state()
+    {
+        m_timeout.cancel();
+    }
+
+    void call()
+    {
+        if ( m_timeout.pending() )
+        {
+            m_pending = true;
+            return;
+        }
+
+        schedule();
+        m_fn();
+    }
+
+private:
+    void schedule()
+    {
+        m_timeout = on_timeout(m_milliseconds, boost::bind(&throttle_state::fire, this));
+    }
+
+    // Calls function for calls that came during the interval
+    void fire()
+    {
+        if ( !m_pending )
+            return;
+
+        m_pending = false;
+        schedule();
+        m_fn();
+    }
+
+    const int m_milliseconds;
+    F m_fn;
+    bool m_pending;
+    timeout_handle m_timeout;
+};
+
+// Copies share the same state, so the handler can be copied into
+// boost::function and native event tables
+template <class State>
+class rate_limited_function
+{
+public:
+    template <class F>
+    rate_limited_function(int milliseconds, const F& f)
+        : m_state(boost::make_shared<State>(milliseconds, f)) {}
+
+    void operator()() const
+    {
+        m_state->call();
+    }
+
+private:
+    boost::shared_ptr<State> m_state;
+};
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+template <class Rep, class Period>
+int to_milliseconds(const std::chrono::duration<Rep, Period>& d)
+{
+    return static_cast<int>(std::chrono::duration_cast<
+                                std::chrono::milliseconds>(d).count());
+}
+#endif
+
+#ifdef BOOST_UI_USE_CHRONO
+template <class Rep, class Period>
+int to_milliseconds(const boost::chrono::duration<Rep, Period>& d)
+{
+    return static_cast<int>(boost::chrono::duration_cast<
+                                boost::chrono::milliseconds>(d).count());
+}
+#endif
+
+#ifdef BOOST_UI_USE_DATE_TIME
+template <class T, typename rep_type>
+int to_milliseconds(const boost::date_time::time_duration<T, rep_type>& td)
+{
+    return static_cast<int>(td.total_milliseconds());
+}
+#endif
+
+} // namespace detail
+
+#endif
+
+/// @brief Function object that calls the wrapped function
+/// after calls stop coming for the specified time duration
+/// @see debounce()
+/// @ingroup event
+template <class F>
+class debounced_function
+#ifndef DOXYGEN
+    : public detail::rate_limited_function< detail::debounce_state<F> >
+#endif
+{
+public:
+#ifndef DOXYGEN
+    debounced_function(int milliseconds, const F& f)
+        : detail::rate_limited_function< detail::debounce_state<F> >(milliseconds, f) {}
+#endif
+};
+
+/// @brief Function object that calls the wrapped function
+/// at most once per the specified time duration
+/// @see throttle()
+/// @ingroup event
+template <class F>
+class throttled_function
+#ifndef DOXYGEN
+    : public detail::rate_limited_function< detail::throttle_state<F> >
+#endif
+{
+public:
+#ifndef DOXYGEN
+    throttled_function(int milliseconds, const F& f)
+        : detail::rate_limited_function< detail::throttle_state<F> >(milliseconds, f) {}
+#endif
+};
+
+///@{ @brief Returns handler that calls @a f when calls stop coming for @a d duration
+/// @details Each call postpones the call, so @a f is called once
+/// after the last call of series, for example after user stops typing.
+/// Handler schedules one timeout per series of calls on the timer wheel
+/// that is shared by all timeouts, so calls don't start native timers.
+/// Usage example:
+/// @code
+/// text_box.on_edit(ui::debounce(std::chrono::milliseconds(300), &update));
+/// @endcode
+/// @see BOOST_UI_USE_CHRONO
+/// @see BOOST_UI_USE_DATE_TIME
+/// @see <a href="http://en.wikipedia.org/wiki/Switch#Contact_bounce">Contact bounce (Wikipedia)</a>
+/// @ingroup event
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+template <class Rep, class Period, class F>
+debounced_function<F> debounce(const std::chrono::duration<Rep, Period>& d, F f)
+{
+    return debounced_function<F>(detail::to_milliseconds(d), f);
+}
+#endif
+
+#ifdef BOOST_UI_USE_CHRONO
+template <class Rep, class Period, class F>
+debounced_function<F> debounce(const boost::chrono::duration<Rep, Period>& d, F f)
+{
+    return debounced_function<F>(detail::to_milliseconds(d), f);
+}
+#endif
+
+#ifdef BOOST_UI_USE_DATE_TIME
+template <class T, typename rep_type, class F>
+debounced_function<F> debounce(const boost::date_time::time_duration<T, rep_type>& td, F f)
+{
+    return debounced_function<F>(detail::to_milliseconds(td), f);
+}
+#endif
+
+///@}
+
+///@{ @brief Returns handler that calls @a f at most once per @a d duration
+/// @details The first call of series calls @a f immediately.
+/// Calls during the next @a d duration are merged into one call
+/// at the end of the duration, so the latest state is always handled.
+/// Handler schedules one timeout per interval on the timer wheel
+/// that is shared by all timeouts, so calls don't start native timers.
+/// Usage example:
+/// @code
+/// slider.on_slide(ui::throttle(std::chrono::milliseconds(100), &update));
+/// @endcode
+/// @see BOOST_UI_USE_CHRONO
+/// @see BOOST_UI_USE_DATE_TIME
+/// @ingroup event
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+template <class Rep, class Period, class F>
+throttled_function<F> throttle(const std::chrono::duration<Rep, Period>& d, F f)
+{
+    return throttled_function<F>(detail::to_milliseconds(d), f);
+}
+#endif
+
+#ifdef BOOST_UI_USE_CHRONO
+template <class Rep, class Period, class F>
+throttled_function<F> throttle(const boost::chrono::duration<Rep, Period>& d, F f)
+{
+    return throttled_function<F>(detail::to_milliseconds(d), f);
+}
+#endif
+
+#ifdef BOOST_UI_USE_DATE_TIME
+template <class T, typename rep_type, class F>
+throttled_function<F> throttle(const boost::date_time::time_duration<T, rep_type>& td, F f)
+{
+    return throttled_function<F>(detail::to_milliseconds(td), f);
+}
+#endif
+
+///@}
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_DEBOUNCE_HPP
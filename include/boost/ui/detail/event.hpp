@@ -11,15 +11,23 @@
 
 #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
 
+// Handler without arguments is stored as is, without std::bind() wrapper
+
 #define BOOST_UI_DETAIL_HANDLER(handler, cls) \
-    template <class F, class ...Args> \
-    cls& on_##handler(F&& f, Args&&... args) \
-        { on_##handler##_raw(std::bind(boost::forward<F>(f), boost::forward<Args>(args)...)); return *this; } \
+    template <class F> \
+    cls& on_##handler(F&& f) \
+        { on_##handler##_raw(boost::forward<F>(f)); return *this; } \
+    template <class F, class Arg1, class ...Args> \
+    cls& on_##handler(F&& f, Arg1&& a1, Args&&... args) \
+        { on_##handler##_raw(std::bind(boost::forward<F>(f), boost::forward<Arg1>(a1), boost::forward<Args>(args)...)); return *this; } \
 
 #define BOOST_UI_DETAIL_HANDLER_EVENT(handler, cls, event) \
-    template <class F, class ...Args> \
-    cls& on_##handler(F&& f, Args&&... args) \
-        { on_##handler##_raw(std::bind(boost::forward<F>(f), boost::forward<Args>(args)..., std::placeholders::_1)); return *this; } \
+    template <class F> \
+    cls& on_##handler(F&& f) \
+        { on_##handler##_raw(boost::forward<F>(f)); return *this; } \
+    template <class F, class Arg1, class ...Args> \
+    cls& on_##handler(F&& f, Arg1&& a1, Args&&... args) \
+        { on_##handler##_raw(std::bind(boost::forward<F>(f), boost::forward<Arg1>(a1), boost::forward<Args>(args)..., std::placeholders::_1)); return *this; } \
 
 #else // defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
 
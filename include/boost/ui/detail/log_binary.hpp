@@ -0,0 +1,166 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_UI_DETAIL_LOG_BINARY_HPP
+#define BOOST_UI_DETAIL_LOG_BINARY_HPP
+
+#include <boost/ui/config.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace boost  {
+namespace ui     {
+namespace detail {
+
+// Binary log file layout, all values use native byte order.
+// File starts with log_binary_file_header that is followed by records,
+// unused tail of the file is filled with zeros.
+// Record with zero size is reserved but not completed yet,
+// readers skip it by alignment steps and accept the next record
+// only if its checksum matches, so payload of incomplete record
+// isn't decoded.
+// Each record starts with log_binary_record_header and is padded
+// to 8 bytes with zeros.
+//
+// Site record payload:
+//   u32 site id, i32 line,
+//   u32 file length, file, u32 function length, function
+//   (log_binary_null length means NULL string)
+//
+// Message record payload is sequence of arguments:
+//   u8 tag with log_binary_spaces and log_binary_quotes flags, value
+
+const char log_binary_magic[8] = { 'B', 'U', 'I', 'L', 'O', 'G', '\0', '\0' };
+const boost::uint32_t log_binary_version = 2;
+const boost::uint32_t log_binary_null = 0xFFFFFFFF;
+const std::size_t log_binary_alignment = 8;
+
+struct log_binary_file_header
+{
+    char magic[8];
+    boost::uint32_t version;
+    boost::uint32_t wchar_size;
+    boost::uint64_t capacity;  // File size
+};
+
+struct log_binary_record_header
+{
+    boost::uint32_t size;      // Written last, includes header and padding
+    boost::uint16_t type;      // log_binary_record_type
+    boost::uint16_t level;     // BOOST_UI_LOG_LEVEL_* value
+    boost::uint32_t checksum;  // log_binary_checksum() of the complete record
+    boost::uint32_t reserved;  // Zero
+    boost::uint64_t timestamp; // Microseconds since the Epoch
+};
+
+// FNV-1a hash step
+inline boost::uint32_t log_binary_hash(boost::uint32_t hash, const void* data,
+                                       std::size_t size)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for ( std::size_t i = 0; i < size; i++ )
+        hash = (hash ^ p[i]) * 16777619u;
+    return hash;
+}
+
+// Hash of header fields except checksum and of @a size bytes
+// of payload with padding
+inline boost::uint32_t log_binary_checksum(const log_binary_record_header& header,
+                                           const char* payload, std::size_t size)
+{
+    boost::uint32_t hash = 2166136261u;
+    hash = log_binary_hash(hash, &header.size,      sizeof header.size);
+    hash = log_binary_hash(hash, &header.type,      sizeof header.type);
+    hash = log_binary_hash(hash, &header.level,     sizeof header.level);
+    hash = log_binary_hash(hash, &header.timestamp, sizeof header.timestamp);
+    return log_binary_hash(hash, payload, size);
+}
+
+enum log_binary_record_type
+{
+    log_binary_site_record = 1,
+    log_binary_message_record
+};
+
+enum log_binary_tag
+{
+    log_binary_location = 1, // u32 site id
+    log_binary_bool,         // u8
+    log_binary_signed,       // i64
+    log_binary_unsigned,     // u64
+    log_binary_float,        // float
+    log_binary_double,       // double
+    log_binary_long_double,  // long double
+    log_binary_char,         // char
+    log_binary_wchar,        // u32
+    log_binary_string,       // u32 length, chars
+    log_binary_wstring,      // u32 length, wchar_t characters
+    log_binary_raw_string,   // u32 length, chars, logged without quotes
+    log_binary_raw_wstring,  // u32 length, wchar_t characters, logged without quotes
+
+    log_binary_tag_mask = 0x3F
+};
+
+const unsigned char log_binary_spaces = 0x40;
+const unsigned char log_binary_quotes = 0x80;
+
+// Collects encoded arguments of log message, reuses capacity after clear()
+class log_binary_buffer
+{
+public:
+    void clear() { m_data.clear(); }
+
+    const char* data() const { return m_data.empty() ? NULL : &m_data[0]; }
+    std::size_t size() const { return m_data.size(); }
+
+    void tag(log_binary_tag value, bool spaces, bool quotes)
+    {
+        m_data.push_back(static_cast<char>(value |
+            (spaces ? log_binary_spaces : 0) | (quotes ? log_binary_quotes : 0)));
+    }
+
+    template <class T>
+    void value(const T& v)
+    {
+        bytes(&v, sizeof v);
+    }
+
+    template <class Char>
+    void string(const Char* str, std::size_t length)
+    {
+        value(static_cast<boost::uint32_t>(length));
+        bytes(str, length * sizeof(Char));
+    }
+
+    void bytes(const void* data, std::size_t size)
+    {
+        const char* p = static_cast<const char*>(data);
+        m_data.insert(m_data.end(), p, p + size);
+    }
+
+private:
+    std::vector<char> m_data;
+};
+
+// Returns nonzero id of the running binary log file or zero
+unsigned log_binary_generation();
+
+// Write records into the running binary log file,
+// return false if it isn't running
+bool log_binary_write_site(boost::uint32_t id, const char* file,
+                           int line, const char* fn);
+bool log_binary_write_message(int level, const log_binary_buffer& args);
+
+// Counts message that was encoded but wasn't written, e.g. when file was stopped
+void log_binary_drop();
+
+} // namespace detail
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_DETAIL_LOG_BINARY_HPP
@@ -0,0 +1,33 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_UI_DETAIL_LOG_SINK_HPP
+#define BOOST_UI_DETAIL_LOG_SINK_HPP
+
+#include <boost/ui/config.hpp>
+#include <boost/ui/string.hpp>
+
+namespace boost  {
+namespace ui     {
+namespace detail {
+
+// Receives copies of text log messages in addition to the log backend,
+// write() is called from logging threads and shouldn't block
+class log_sink
+{
+public:
+    virtual ~log_sink() {}
+    virtual void write(int level, const uistring& text) = 0;
+};
+
+// remove_log_sink() waits until other threads finish writing into the sink
+void add_log_sink(log_sink* sink);
+void remove_log_sink(log_sink* sink);
+
+} // namespace detail
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_DETAIL_LOG_SINK_HPP
@@ -0,0 +1,85 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_UI_DETAIL_TIMER_WHEEL_HPP
+#define BOOST_UI_DETAIL_TIMER_WHEEL_HPP
+
+#include <boost/ui/config.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <vector>
+
+namespace boost  {
+namespace ui     {
+namespace detail {
+
+// Hierarchical timer wheel with 1 tick resolution, see
+// "Hashed and Hierarchical Timing Wheels" by G. Varghese and T. Lauck.
+// 4 levels of 64 slots cover 2^24 ticks, later timers wait in overflow list.
+// Scheduling and cancelling take constant time and don't allocate memory
+// when there are free nodes. Not thread safe.
+class BOOST_UI_DECL timer_wheel : private boost::noncopyable
+{
+public:
+    // Zero is never used as valid id
+    typedef boost::uint64_t id_type;
+
+    explicit timer_wheel(boost::uint64_t now = 0);
+
+    // Calls fn when advance() reaches expiry or later time,
+    // expired time is called at the next tick
+    id_type schedule(boost::uint64_t expiry, const boost::function<void()>& fn);
+
+    // Returns true if timer was pending
+    bool cancel(id_type id);
+
+    bool pending(id_type id) const;
+
+    // Calls functions of all timers that expire at or before now
+    void advance(boost::uint64_t now);
+
+    // Returns time when advance() should be called next time
+    // or maximal value if there are no timers
+    boost::uint64_t next_expiry() const;
+
+    boost::uint64_t now() const { return m_now; }
+    std::size_t size() const { return m_count; }
+
+private:
+    typedef boost::uint32_t index_type;
+
+    struct node
+    {
+        index_type prev;
+        index_type next;
+        index_type list;
+        boost::uint32_t generation;
+        boost::uint64_t expiry;
+        boost::function<void()> fn;
+    };
+
+    void insert(index_type index);
+    void link(index_type list, index_type index);
+    void unlink(index_type index);
+    void release(index_type index);
+    void cascade(index_type list);
+    void tick();
+    void fire_due();
+
+    std::vector<node> m_nodes;
+    index_type m_free;
+    std::size_t m_count;
+    boost::uint64_t m_now;
+    boost::uint64_t m_occupied[4];
+};
+
+} // namespace detail
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_DETAIL_TIMER_WHEEL_HPP
@@ -0,0 +1,71 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_UI_DETAIL_TO_CHARS_HPP
+#define BOOST_UI_DETAIL_TO_CHARS_HPP
+
+#include <boost/ui/config.hpp>
+#include <boost/ui/string.hpp>
+
+namespace boost  {
+namespace ui     {
+namespace detail {
+
+/// Buffer size that is enough for any integral value
+const std::size_t to_chars_integer_size = 24;
+
+///@{ Writes value into [first, last) range without allocations,
+///   returns pointer past the last written character or NULL on overflow
+BOOST_UI_DECL char* to_chars(char* first, char* last, long long value);
+BOOST_UI_DECL char* to_chars(char* first, char* last, unsigned long long value);
+
+inline char* to_chars(char* first, char* last, short value)
+    { return to_chars(first, last, static_cast<long long>(value)); }
+inline char* to_chars(char* first, char* last, unsigned short value)
+    { return to_chars(first, last, static_cast<unsigned long long>(value)); }
+inline char* to_chars(char* first, char* last, int value)
+    { return to_chars(first, last, static_cast<long long>(value)); }
+inline char* to_chars(char* first, char* last, unsigned int value)
+    { return to_chars(first, last, static_cast<unsigned long long>(value)); }
+inline char* to_chars(char* first, char* last, long value)
+    { return to_chars(first, last, static_cast<long long>(value)); }
+inline char* to_chars(char* first, char* last, unsigned long value)
+    { return to_chars(first, last, static_cast<unsigned long long>(value)); }
+
+// Negative precision means the shortest representation
+// that is parsed back to the same value
+BOOST_UI_DECL char* to_chars(char* first, char* last, float value,
+                             chars_format fmt = chars_format::general,
+                             int precision = -1);
+BOOST_UI_DECL char* to_chars(char* first, char* last, double value,
+                             chars_format fmt = chars_format::general,
+                             int precision = -1);
+BOOST_UI_DECL char* to_chars(char* first, char* last, long double value,
+                             chars_format fmt = chars_format::general,
+                             int precision = -1);
+///@}
+
+///@{ Appends value to the string without temporary strings
+template <class T>
+void append_integer(uistring& str, T value)
+{
+    char buffer[to_chars_integer_size];
+    const char* end = to_chars(buffer, buffer + to_chars_integer_size, value);
+    str.append_ascii(buffer, end - buffer);
+}
+
+BOOST_UI_DECL void append_floating(uistring& str, float value,
+                                   chars_format fmt, int precision);
+BOOST_UI_DECL void append_floating(uistring& str, double value,
+                                   chars_format fmt, int precision);
+BOOST_UI_DECL void append_floating(uistring& str, long double value,
+                                   chars_format fmt, int precision);
+///@}
+
+} // namespace detail
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_DETAIL_TO_CHARS_HPP
@@ -18,6 +18,8 @@
 
 #include <boost/function.hpp>
 
+#include <vector>
+
 namespace boost  {
 namespace ui     {
 
@@ -27,6 +29,9 @@ namespace native {
 template <class NativeEvent, class UIEvent>
 class event_functor_event;
 
+template <class UIEvent>
+class coalesced_event_functor;
+
 } // namespace native
 #endif
 
@@ -161,16 +166,30 @@ public:
     bool middle() const { return m_middle; }
     ///@}
 
+    /// @brief Returns count of native events that were merged into this event
+    /// @details It is greater than 1 only for coalesced event handlers
+    std::size_t count() const { return m_count; }
+
+    /// @brief Returns positions of all merged events from the oldest one
+    /// @details It is empty except for widget::on_coalesced_mouse_history_event() handlers.
+    /// Use it to draw smooth lines by mouse.
+    const std::vector<point>& history() const;
+
 private:
     coord_type m_x;
     coord_type m_y;
     bool m_left;
     bool m_right;
     bool m_middle;
+    std::size_t m_count;
+    const std::vector<point>* m_history;
 
 #ifndef DOXYGEN
     template <class NativeEvent, class UIEvent>
     friend class native::event_functor_event;
+
+    template <class UIEvent>
+    friend class native::coalesced_event_functor;
 #endif
 };
 
@@ -201,6 +220,9 @@ private:
 #ifndef DOXYGEN
     template <class NativeEvent, class UIEvent>
     friend class native::event_functor_event;
+
+    template <class UIEvent>
+    friend class native::coalesced_event_functor;
 #endif
 };
 
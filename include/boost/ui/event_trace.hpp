@@ -0,0 +1,126 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file event_trace.hpp Event handler tracing and latency histograms
+
+#ifndef BOOST_UI_EVENT_TRACE_HPP
+#define BOOST_UI_EVENT_TRACE_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/string.hpp>
+#include <boost/cstdint.hpp>
+
+#include <iosfwd>
+#include <vector>
+
+namespace boost {
+namespace ui    {
+
+/// @brief Histogram of durations in microseconds with bounded relative error
+/// @details Values below 64 are stored exactly, larger values are stored
+/// in 32 buckets per power of two, so relative error is less than 1/32.
+/// Recording a value takes constant time and doesn't allocate memory.
+/// Values above 2<sup>32</sup> microseconds are stored as 2<sup>32</sup> - 1.
+/// @see <a href="http://hdrhistogram.org/">HdrHistogram</a>
+/// @ingroup event
+
+class BOOST_UI_DECL latency_histogram
+{
+public:
+    /// Unsigned integral type
+    typedef boost::uint64_t size_type;
+
+    latency_histogram();
+
+    /// Adds @a microseconds value
+    void record(boost::uint64_t microseconds);
+
+    /// Removes all values
+    void clear();
+
+    /// Returns count of recorded values
+    size_type count() const { return m_count; }
+
+    /// Returns the smallest recorded value or 0 if histogram is empty
+    boost::uint64_t min_value() const;
+
+    /// Returns the largest recorded value or 0 if histogram is empty
+    boost::uint64_t max_value() const { return m_max; }
+
+    /// Returns arithmetic mean of recorded values or 0 if histogram is empty
+    double mean() const;
+
+    /// @brief Returns value that is greater than or equivalent to
+    /// @a percentile percents of recorded values
+    /// @details @a percentile should be in the [0, 100] range
+    boost::uint64_t value_at_percentile(double percentile) const;
+
+private:
+    std::vector<size_type> m_buckets;
+    size_type m_count;
+    boost::uint64_t m_min;
+    boost::uint64_t m_max;
+    double m_sum;
+};
+
+/// @brief Records invocations of event handlers
+/// @details When tracing is running, each event handler invocation records
+/// event type, widget, start time, duration
+/// and time that event spent in the queue, when it is known.
+/// When tracing is stopped, the overhead is one branch per event.
+/// All functions should be called from the UI thread.
+/// @ingroup event
+
+class BOOST_UI_DECL event_trace
+{
+public:
+    /// Statistics of one event handler
+    struct handler_stats
+    {
+        /// Event type, widget class and widget name
+        uistring name;
+
+        /// Durations of handler invocations
+        latency_histogram duration;
+
+        /// Time between event creation and handler invocation
+        latency_histogram queue_latency;
+    };
+
+    /// @brief Starts tracing
+    /// @details Stores up to @a capacity invocations for write_chrome_trace(),
+    /// histograms are updated after that too.
+    static void start(std::size_t capacity = 1000000);
+
+    /// Stops tracing, recorded data are kept
+    static void stop();
+
+    /// Returns true if tracing is running
+    static bool running();
+
+    /// Removes all recorded data
+    static void clear();
+
+    /// Returns statistics of all handlers that were invoked during tracing
+    static std::vector<handler_stats> handlers();
+
+    /// Returns count of invocations that weren't stored because of capacity
+    static std::size_t dropped_count();
+
+    /// @brief Writes stored invocations in the Chrome trace event JSON format
+    /// @details Result can be opened in chrome://tracing or Perfetto UI
+    /// @see <a href="https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU">Trace Event Format</a>
+    static void write_chrome_trace(std::ostream& os);
+};
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_EVENT_TRACE_HPP
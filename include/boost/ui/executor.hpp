@@ -0,0 +1,364 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file executor.hpp UI thread executor and thread pool
+
+#ifndef BOOST_UI_EXECUTOR_HPP
+#define BOOST_UI_EXECUTOR_HPP
+
+#ifdef DOXYGEN
+#define BOOST_UI_USE_ASIO
+#endif
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/cancellation.hpp>
+#include <boost/ui/thread.hpp>
+
+#include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#ifdef BOOST_UI_USE_ASIO
+#include <boost/asio/execution_context.hpp>
+#endif
+
+#if !defined(BOOST_NO_CXX11_HDR_FUTURE) && !defined(BOOST_NO_CXX11_DECLTYPE)
+#include <future>
+#include <utility>
+#endif
+
+namespace boost {
+namespace ui    {
+
+#ifndef DOXYGEN
+
+namespace detail {
+
+// Stores move-only function objects, such as Boost.Asio handlers,
+// so they can be queued as boost::function
+template <class F>
+class shared_function
+{
+public:
+    explicit shared_function(BOOST_RV_REF(F) f)
+        : m_fn(boost::make_shared<F>(boost::move(f))) {}
+    explicit shared_function(const F& f)
+        : m_fn(boost::make_shared<F>(f)) {}
+
+    void operator()() const
+    {
+        (*m_fn)();
+    }
+
+private:
+    boost::shared_ptr<F> m_fn;
+};
+
+template <class F>
+boost::function<void()> make_function(F f)
+{
+    return shared_function<F>(boost::move(f));
+}
+
+// Skips function if its token was cancelled before it is started
+template <class F>
+class cancellable_function
+{
+public:
+    cancellable_function(const cancellation_token& token, BOOST_RV_REF(F) f)
+        : m_token(token), m_fn(boost::move(f)) {}
+    cancellable_function(const cancellation_token& token, const F& f)
+        : m_token(token), m_fn(f) {}
+
+    void operator()()
+    {
+        if ( !m_token.cancelled() )
+            m_fn();
+    }
+
+private:
+    cancellation_token m_token;
+    F m_fn;
+};
+
+#ifdef BOOST_UI_USE_ASIO
+inline boost::asio::execution_context& asio_context()
+{
+    static boost::asio::execution_context context;
+    return context;
+}
+#endif
+
+BOOST_UI_DECL bool is_ui_thread();
+
+} // namespace detail
+
+#endif
+
+/// @brief Executor that calls functions in the UI thread
+/// @details Meets requirements of Boost.Asio executors if
+/// BOOST_UI_USE_ASIO is defined and requirements of Boost.Thread executors,
+/// so it can be used in @c boost::asio::post() and @c boost::future::then().
+/// Functions are queued by call_async(). This class is thread safe.
+/// Usage example:
+/// @code
+/// boost::async(pool, &load).then(ui::executor(), [&](boost::future<data> f)
+/// {
+///     view.show(f.get());
+/// });
+/// @endcode
+/// @see thread_pool
+/// @ingroup thread
+
+class executor
+{
+public:
+    ///@{ Queues @a f to be called in the UI thread
+    template <class F>
+    void post(F f) const
+    {
+        detail::call_async(detail::make_function(boost::move(f)));
+    }
+    void post(const boost::function<void()>& fn) const
+    {
+        detail::call_async(fn);
+    }
+    ///@}
+
+    /// Calls @a f immediately if it is called from the UI thread, queues it otherwise
+    template <class F>
+    void dispatch(F f) const
+    {
+        if ( running_in_this_thread() )
+            f();
+        else
+            post(boost::move(f));
+    }
+
+    /// Returns true if it is called from the UI thread
+    bool running_in_this_thread() const
+    {
+        return detail::is_ui_thread();
+    }
+
+    ///@{ Boost.Asio executor requirements
+#ifdef BOOST_UI_USE_ASIO
+    boost::asio::execution_context& context() const
+        { return detail::asio_context(); }
+#endif
+    void on_work_started() const {}
+    void on_work_finished() const {}
+    template <class F, class Allocator>
+    void post(F f, const Allocator&) const
+        { post(boost::move(f)); }
+    template <class F, class Allocator>
+    void dispatch(F f, const Allocator&) const
+        { dispatch(boost::move(f)); }
+    template <class F, class Allocator>
+    void defer(F f, const Allocator&) const
+        { post(boost::move(f)); }
+    ///@}
+
+    ///@{ Boost.Thread executor requirements
+    template <class F>
+    void submit(BOOST_FWD_REF(F) f)
+        { post(boost::forward<F>(f)); }
+    template <class F>
+    void execute(BOOST_FWD_REF(F) f) const
+        { post(boost::forward<F>(f)); }
+    void close() {}
+    bool closed() const { return false; }
+    bool try_executing_one() { return false; }
+    template <class Pred>
+    bool reschedule_until(const Pred&) { return false; }
+    ///@}
+
+    friend bool operator==(const executor&, const executor&) { return true; }
+    friend bool operator!=(const executor&, const executor&) { return false; }
+};
+
+/// @brief Pool of background threads that call queued functions
+/// @details Each thread has its own queue, functions that are posted
+/// from the pool thread are queued there and called in LIFO order,
+/// idle threads steal the oldest functions from other queues.
+/// Functions that are posted from other threads are queued
+/// into the shared queue, that can be bounded.
+/// Destructor waits until all queued functions are called.
+/// Exception that leaves function is rethrown in the UI thread.
+/// The pool and its executor are thread safe.
+/// @see executor, cancellation_token
+/// @ingroup thread
+
+class BOOST_UI_DECL thread_pool : private boost::noncopyable
+{
+public:
+    /// @brief Starts @a threads threads
+    /// @details 0 means count of CPU cores.
+    /// If @a capacity isn't 0, post() from outside of the pool blocks
+    /// while the shared queue contains @a capacity functions.
+    /// Queues of the pool threads aren't bounded,
+    /// so functions that post other functions can't deadlock.
+    explicit thread_pool(std::size_t threads = 0, std::size_t capacity = 0);
+
+    /// Waits until all queued functions are called and stops threads
+    ~thread_pool();
+
+    /// Returns count of threads
+    std::size_t size() const;
+
+    ///@{ Queues @a f to be called by one of threads
+    template <class F>
+    void post(F f)
+    {
+        post_raw(detail::make_function(boost::move(f)));
+    }
+    void post(const boost::function<void()>& fn)
+    {
+        post_raw(fn);
+    }
+    ///@}
+
+    /// @brief Queues @a f that is skipped if @a token is cancelled before it is started
+    /// @details Long running function should check the token itself.
+    template <class F>
+    void post(const cancellation_token& token, F f)
+    {
+        post_raw(detail::make_function(
+            detail::cancellable_function<F>(token, boost::move(f))));
+    }
+
+    /// Returns maximum count of functions in the shared queue or 0 if it is unbounded
+    std::size_t capacity() const;
+
+    /// Returns true if it is called from one of threads of this pool
+    bool running_in_this_thread() const;
+
+    ///@{ Boost.Thread executor requirements
+    template <class F>
+    void submit(BOOST_FWD_REF(F) f)
+        { post(boost::forward<F>(f)); }
+    void close();
+    bool closed() const;
+    bool try_executing_one();
+    template <class Pred>
+    bool reschedule_until(const Pred&) { return false; }
+    ///@}
+
+    /// @brief Lightweight executor of the pool
+    /// @details Meets requirements of Boost.Asio executors if
+    /// BOOST_UI_USE_ASIO is defined. Pool should outlive its executors.
+    class executor_type
+    {
+    public:
+        explicit executor_type(thread_pool& pool) : m_pool(&pool) {}
+
+        /// Queues @a f to be called by one of threads
+        template <class F>
+        void post(F f) const
+            { m_pool->post(boost::move(f)); }
+
+        /// Calls @a f immediately if it is called from the pool, queues it otherwise
+        template <class F>
+        void dispatch(F f) const
+        {
+            if ( running_in_this_thread() )
+                f();
+            else
+                post(boost::move(f));
+        }
+
+        /// Returns true if it is called from one of threads of the pool
+        bool running_in_this_thread() const
+            { return m_pool->running_in_this_thread(); }
+
+        ///@{ Boost.Asio executor requirements
+#ifdef BOOST_UI_USE_ASIO
+        boost::asio::execution_context& context() const
+            { return detail::asio_context(); }
+#endif
+        void on_work_started() const {}
+        void on_work_finished() const {}
+        template <class F, class Allocator>
+        void post(F f, const Allocator&) const
+            { post(boost::move(f)); }
+        template <class F, class Allocator>
+        void dispatch(F f, const Allocator&) const
+            { dispatch(boost::move(f)); }
+        template <class F, class Allocator>
+        void defer(F f, const Allocator&) const
+            { post(boost::move(f)); }
+        template <class F>
+        void execute(BOOST_FWD_REF(F) f) const
+            { post(boost::forward<F>(f)); }
+        ///@}
+
+        friend bool operator==(const executor_type& a, const executor_type& b)
+            { return a.m_pool == b.m_pool; }
+        friend bool operator!=(const executor_type& a, const executor_type& b)
+            { return a.m_pool != b.m_pool; }
+
+    private:
+        thread_pool* m_pool;
+    };
+
+    /// Returns executor of this pool
+    executor_type get_executor()
+        { return executor_type(*this); }
+
+private:
+    void post_raw(const boost::function<void()>& fn);
+
+    class impl;
+    impl* m_impl;
+};
+
+#if !defined(BOOST_NO_CXX11_HDR_FUTURE) && !defined(BOOST_NO_CXX11_DECLTYPE)
+
+#ifndef DOXYGEN
+
+namespace detail {
+
+// std::result_of is removed in C++20
+template <class F>
+struct async_result
+{
+    typedef decltype(std::declval<F&>()()) type;
+};
+
+} // namespace detail
+
+#endif
+
+/// @brief Calls @a f by @a ex executor and returns its result as std::future
+/// @details Usage example:
+/// @code
+/// std::future<data> f = ui::async(pool, &load);
+/// @endcode
+/// @ingroup thread
+template <class Executor, class F>
+std::future<typename detail::async_result<F>::type> async(Executor& ex, F f)
+{
+    typedef typename detail::async_result<F>::type result_type;
+
+    boost::shared_ptr< std::packaged_task<result_type()> > task =
+        boost::make_shared< std::packaged_task<result_type()> >(boost::move(f));
+    std::future<result_type> result = task->get_future();
+    ex.post([task] { (*task)(); });
+    return result;
+}
+
+#endif
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_EXECUTOR_HPP
@@ -0,0 +1,99 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file fd_watcher.hpp Watching of file descriptors in the UI event loop
+
+#ifndef BOOST_UI_FD_WATCHER_HPP
+#define BOOST_UI_FD_WATCHER_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/detail/event.hpp>
+
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace boost {
+namespace ui    {
+
+/// @brief Calls handlers in the UI thread when file descriptor or socket is ready
+/// @details Descriptor is watched by the native event loop directly,
+/// so I/O is handled without worker thread and call_async().
+/// Descriptor should be non-blocking, handlers should read or write
+/// until operation would block. Watcher doesn't close descriptor.
+/// Supported on POSIX systems only, see is_supported().
+/// Usage example with Boost.Asio socket:
+/// @code
+/// socket.non_blocking(true);
+/// watcher.create(socket.native_handle()).on_read([&]
+/// {
+///     boost::system::error_code ec;
+///     std::size_t size;
+///     while ( (size = socket.read_some(boost::asio::buffer(buffer), ec)) > 0 )
+///         process(buffer, size);
+///     if ( ec != boost::asio::error::would_block )
+///         watcher.close();
+/// });
+/// @endcode
+/// @see <a href="http://en.wikipedia.org/wiki/Event_loop">Event loop (Wikipedia)</a>
+/// @ingroup event
+
+class BOOST_UI_DECL fd_watcher : private boost::noncopyable
+{
+public:
+    fd_watcher() : m_impl(NULL) {}
+
+    ///@{ Starts watching of @a fd descriptor
+    explicit fd_watcher(int fd) : m_impl(NULL) { create(fd); }
+    fd_watcher& create(int fd);
+    ///@}
+
+    /// Stops watching
+    ~fd_watcher();
+
+    /// Connects handler that is called when descriptor has data to read
+    BOOST_UI_DETAIL_HANDLER(read, fd_watcher);
+
+    /// @brief Connects handler that is called when descriptor can be written
+    /// @details Handler is called repeatedly while writing doesn't block,
+    /// so watching should be disabled when there are no data to write.
+    /// @see enable_write()
+    BOOST_UI_DETAIL_HANDLER(write, fd_watcher);
+
+    /// Connects handler that is called on error or hang up
+    BOOST_UI_DETAIL_HANDLER(error, fd_watcher);
+
+    /// Enables or disables calling of the write handler
+    fd_watcher& enable_write(bool enable = true);
+
+    /// Stops watching, handlers are disconnected
+    void close();
+
+    /// Returns true if descriptor is watched
+    bool is_open() const;
+
+    /// Returns watched descriptor or -1
+    int fd() const;
+
+    /// Returns true if descriptors watching is supported by the native event loop
+    static bool is_supported();
+
+private:
+    void on_read_raw(const boost::function<void()>& handler);
+    void on_write_raw(const boost::function<void()>& handler);
+    void on_error_raw(const boost::function<void()>& handler);
+
+    class impl;
+    impl* m_impl;
+};
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_FD_WATCHER_HPP
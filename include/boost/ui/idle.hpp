@@ -0,0 +1,108 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file idle.hpp Tasks that are called when the event loop is idle
+
+#ifndef BOOST_UI_IDLE_HPP
+#define BOOST_UI_IDLE_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#endif
+
+#ifdef BOOST_UI_USE_CHRONO
+#include <boost/chrono.hpp>
+#endif
+
+#ifdef BOOST_UI_USE_DATE_TIME
+#include <boost/date_time/time_duration.hpp>
+#endif
+
+#include <cstddef>
+
+namespace boost {
+namespace ui    {
+
+#ifndef DOXYGEN
+
+namespace detail {
+BOOST_UI_DECL void idle_budget(boost::uint64_t microseconds);
+
+// Releases queued tasks when application exits
+BOOST_UI_DECL void clear_idle_tasks();
+} // namespace detail
+
+#endif
+
+/// @brief Queues @a task to be called in the UI thread when the event loop is idle
+/// @details Tasks with higher @a priority are called first,
+/// tasks with equal priority are called in queuing order.
+/// Tasks are called one by one until the time budget of the event loop
+/// iteration is used up, then the loop processes pending events.
+/// At least one task is called per iteration, so long work
+/// should be split into short tasks that queue each other.
+/// Idle events are requested only while there are queued tasks.
+/// Should be called from the UI thread, use call_async() from other threads.
+/// Usage example:
+/// @code
+/// for ( std::size_t i = 0; i < images.size(); i++ )
+///     ui::on_idle(boost::bind(&cache::warm, &c, images[i]), i < visible ? 1 : 0);
+/// @endcode
+/// @see idle_budget()
+/// @ingroup event
+BOOST_UI_DECL void on_idle(const boost::function<void()>& task, int priority = 0);
+
+/// Returns count of tasks that were queued by on_idle() and weren't called yet
+BOOST_UI_DECL std::size_t idle_tasks_count();
+
+///@{ @brief Sets time that idle tasks can take per event loop iteration
+/// @details Default budget is 4 milliseconds,
+/// so idle tasks don't delay frames of 16 milliseconds.
+/// @see on_idle()
+/// @see BOOST_UI_USE_CHRONO
+/// @see BOOST_UI_USE_DATE_TIME
+/// @ingroup event
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+template <class Rep, class Period>
+void idle_budget(const std::chrono::duration<Rep, Period>& d)
+{
+    detail::idle_budget(static_cast<boost::uint64_t>(std::chrono::duration_cast<
+                            std::chrono::microseconds>(d).count()));
+}
+#endif
+
+#ifdef BOOST_UI_USE_CHRONO
+template <class Rep, class Period>
+void idle_budget(const boost::chrono::duration<Rep, Period>& d)
+{
+    detail::idle_budget(static_cast<boost::uint64_t>(boost::chrono::duration_cast<
+                            boost::chrono::microseconds>(d).count()));
+}
+#endif
+
+#ifdef BOOST_UI_USE_DATE_TIME
+template <class T, typename rep_type>
+void idle_budget(const boost::date_time::time_duration<T, rep_type>& td)
+{
+    detail::idle_budget(static_cast<boost::uint64_t>( td.total_microseconds() ));
+}
+#endif
+
+///@}
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_IDLE_HPP
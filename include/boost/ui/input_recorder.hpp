@@ -0,0 +1,119 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file input_recorder.hpp Recording and replaying of user input
+
+#ifndef BOOST_UI_INPUT_RECORDER_HPP
+#define BOOST_UI_INPUT_RECORDER_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/event_trace.hpp>
+
+#include <iosfwd>
+
+namespace boost {
+namespace ui    {
+
+/// @brief Records keyboard and mouse events of all widgets
+/// @details Each event is stored with its time and path of the target widget,
+/// which is the list of child indices starting from the top level window.
+/// Recording doesn't change event processing.
+/// All functions should be called from the UI thread.
+/// @see input_replayer
+/// @ingroup event
+
+class BOOST_UI_DECL input_recorder
+{
+public:
+    input_recorder();
+    ~input_recorder();
+
+    /// Starts recording, time of events is counted from the first start
+    void start();
+
+    /// Stops recording, recorded events are kept
+    void stop();
+
+    /// Returns true if recording is running
+    bool running() const;
+
+    /// Removes all recorded events
+    void clear();
+
+    /// Returns count of recorded events
+    std::size_t size() const;
+
+    /// Writes recorded events in the text format, one event per line
+    void save(std::ostream& os) const;
+
+private:
+    input_recorder(const input_recorder&);
+    input_recorder& operator=(const input_recorder&);
+
+    class impl;
+    impl* m_impl;
+};
+
+/// @brief Replays events that were saved by @ref input_recorder
+/// @details Events are queued to the same widgets in the same order,
+/// so replaying is deterministic for the same widgets layout.
+/// Events are delivered to the event handlers of widgets only,
+/// native controls don't receive them, so for example text isn't typed
+/// into the text box and button isn't pressed by replayed mouse clicks.
+/// Events of widgets without top level parent aren't recorded.
+/// Latency of each event is measured from its scheduled time
+/// until the end of its processing.
+/// All functions should be called from the UI thread.
+/// @ingroup event
+
+class BOOST_UI_DECL input_replayer
+{
+public:
+    input_replayer();
+    ~input_replayer();
+
+    /// @brief Loads events from @a is
+    /// @return false if @a is contains lines in unknown format,
+    /// no events are loaded then
+    bool load(std::istream& is);
+
+    /// @brief Sets replaying speed
+    /// @details 1 replays with original timing, 2 replays two times faster,
+    /// 0 replays as fast as possible
+    input_replayer& speed(double factor);
+
+    /// Returns replaying speed
+    double speed() const;
+
+    /// @brief Replays all loaded events and waits until they are processed
+    /// @details Events of the running application are processed during waiting
+    void replay();
+
+    /// Returns count of loaded events
+    std::size_t size() const;
+
+    /// Returns count of events that weren't replayed because widgets weren't found
+    std::size_t missing_count() const;
+
+    /// Returns processing latency of replayed events in microseconds
+    const latency_histogram& latency() const;
+
+private:
+    input_replayer(const input_replayer&);
+    input_replayer& operator=(const input_replayer&);
+
+    class impl;
+    impl* m_impl;
+};
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_INPUT_RECORDER_HPP
@@ -0,0 +1,253 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file interval.hpp Periodic timers
+
+#ifndef BOOST_UI_INTERVAL_HPP
+#define BOOST_UI_INTERVAL_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/event_trace.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#endif
+
+#ifdef BOOST_UI_USE_CHRONO
+#include <boost/chrono.hpp>
+#endif
+
+#ifdef BOOST_UI_USE_DATE_TIME
+#include <boost/date_time/time_duration.hpp>
+#endif
+
+#ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
+#include <boost/move/utility.hpp>
+#else
+#include <boost/bind.hpp>
+#endif
+
+namespace boost {
+namespace ui    {
+
+/// @brief Statistics of the periodic timer
+/// @ingroup event
+struct interval_stats
+{
+    /// Count of function calls
+    boost::uint64_t ticks;
+
+    /// Count of deadlines that were skipped because previous call was too late
+    boost::uint64_t missed;
+
+    /// Delays of function calls after their deadlines in microseconds
+    latency_histogram lateness;
+};
+
+#ifndef DOXYGEN
+namespace detail {
+class interval_impl;
+} // namespace detail
+#endif
+
+/// @brief Handle of the periodic timer that was started by on_interval()
+/// @details Copies refer to the same timer. Should be used in the UI thread.
+/// Timer isn't stopped when handle is destroyed.
+/// @ingroup event
+class BOOST_UI_DECL interval_handle
+{
+public:
+    /// Constructs handle that doesn't refer to any timer
+    interval_handle() {}
+
+    /// Stops the timer, returns false if it was already stopped
+    bool cancel();
+
+    /// Returns true if the timer wasn't stopped
+    bool running() const;
+
+    /// Returns statistics of the timer, they are kept after stopping
+    interval_stats stats() const;
+
+#ifndef DOXYGEN
+    explicit interval_handle(const boost::shared_ptr<detail::interval_impl>& impl)
+        : m_impl(impl) {}
+#endif
+
+private:
+    boost::shared_ptr<detail::interval_impl> m_impl;
+};
+
+#ifndef DOXYGEN
+
+namespace detail {
+BOOST_UI_DECL interval_handle on_interval(boost::uint64_t microseconds,
+                                          const boost::function<void()>& fn);
+
+// Stops all timers when application exits
+BOOST_UI_DECL void cancel_intervals();
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+template <class Rep, class Period>
+interval_handle on_interval(const std::chrono::duration<Rep, Period>& d,
+                            const boost::function<void()>& fn)
+{
+    return on_interval(static_cast<boost::uint64_t>(std::chrono::duration_cast<
+                           std::chrono::microseconds>(d).count()),
+                       fn);
+}
+#endif
+
+#ifdef BOOST_UI_USE_CHRONO
+template <class Rep, class Period>
+interval_handle on_interval(const boost::chrono::duration<Rep, Period>& d,
+                            const boost::function<void()>& fn)
+{
+    return on_interval(static_cast<boost::uint64_t>(boost::chrono::duration_cast<
+                           boost::chrono::microseconds>(d).count()),
+                       fn);
+}
+#endif
+
+#ifdef BOOST_UI_USE_DATE_TIME
+template <class T, typename rep_type>
+interval_handle on_interval(const boost::date_time::time_duration<T, rep_type>& td,
+                            const boost::function<void()>& fn)
+{
+    return on_interval(static_cast<boost::uint64_t>( td.total_microseconds() ), fn);
+}
+#endif
+
+} // namespace detail
+
+#endif
+
+///@{ @brief Calls function in the UI thread periodically until the timer is cancelled
+/// @details Deadlines are multiples of the period from the start time,
+/// so lateness of calls doesn't accumulate.
+/// If a call is later than the next deadline, the skipped deadlines
+/// are counted as missed instead of calling function several times in a row.
+/// Periods that are whole milliseconds use the shared timer of on_timeout().
+/// Other periods use a separate timer thread
+/// (timerfd on Linux) that provides sub-millisecond resolution.
+/// Usage example:
+/// @code
+/// ui::interval_handle refresh = ui::on_interval(std::chrono::microseconds(16667),
+///                                               &my_canvas::redraw, &canvas);
+/// ...
+/// const ui::interval_stats stats = refresh.stats();
+/// ui::log::info() << "missed: " << stats.missed
+///                 << ", p99 lateness: " << stats.lateness.value_at_percentile(99) << " us";
+/// @endcode
+/// @see on_timeout
+/// @see BOOST_UI_USE_CHRONO
+/// @see BOOST_UI_USE_DATE_TIME
+/// @ingroup event
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+template <class Rep, class Period, class F, class ...Args>
+interval_handle on_interval(const std::chrono::duration<Rep, Period>& d,
+                            F&& f, Args&&... args)
+{
+    return detail::on_interval(d, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
+}
+#else
+template <class Rep, class Period>
+interval_handle on_interval(const std::chrono::duration<Rep, Period>& d,
+                            const boost::function<void()>& fn)
+{
+    return detail::on_interval(d, fn);
+}
+template <class Rep, class Period, class F, class Arg1>
+interval_handle on_interval(const std::chrono::duration<Rep, Period>& d,
+                            F f, Arg1 a1)
+{
+    return detail::on_interval(d, boost::bind(f, a1));
+}
+template <class Rep, class Period, class F, class Arg1, class Arg2>
+interval_handle on_interval(const std::chrono::duration<Rep, Period>& d,
+                            F f, Arg1 a1, Arg2 a2)
+{
+    return detail::on_interval(d, boost::bind(f, a1, a2));
+}
+#endif
+#endif
+
+#ifdef BOOST_UI_USE_CHRONO
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+template <class Rep, class Period, class F, class ...Args>
+interval_handle on_interval(const boost::chrono::duration<Rep, Period>& d,
+                            F&& f, Args&&... args)
+{
+    return detail::on_interval(d, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
+}
+#else
+template <class Rep, class Period>
+interval_handle on_interval(const boost::chrono::duration<Rep, Period>& d,
+                            const boost::function<void()>& fn)
+{
+    return detail::on_interval(d, fn);
+}
+template <class Rep, class Period, class F, class Arg1>
+interval_handle on_interval(const boost::chrono::duration<Rep, Period>& d,
+                            F f, Arg1 a1)
+{
+    return detail::on_interval(d, boost::bind(f, a1));
+}
+template <class Rep, class Period, class F, class Arg1, class Arg2>
+interval_handle on_interval(const boost::chrono::duration<Rep, Period>& d,
+                            F f, Arg1 a1, Arg2 a2)
+{
+    return detail::on_interval(d, boost::bind(f, a1, a2));
+}
+#endif
+#endif
+
+#ifdef BOOST_UI_USE_DATE_TIME
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+template <class T, typename rep_type, class F, class ...Args>
+interval_handle on_interval(const boost::date_time::time_duration<T, rep_type>& td,
+                            F&& f, Args&&... args)
+{
+    return detail::on_interval(td, std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
+}
+#else
+template <class T, typename rep_type>
+interval_handle on_interval(const boost::date_time::time_duration<T, rep_type>& td,
+                            const boost::function<void()>& fn)
+{
+    return detail::on_interval(td, fn);
+}
+template <class T, typename rep_type, class F, class Arg1>
+interval_handle on_interval(const boost::date_time::time_duration<T, rep_type>& td,
+                            F f, Arg1 a1)
+{
+    return detail::on_interval(td, boost::bind(f, a1));
+}
+template <class T, typename rep_type, class F, class Arg1, class Arg2>
+interval_handle on_interval(const boost::date_time::time_duration<T, rep_type>& td,
+                            F f, Arg1 a1, Arg2 a2)
+{
+    return detail::on_interval(td, boost::bind(f, a1, a2));
+}
+#endif
+#endif
+
+///@}
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_INTERVAL_HPP
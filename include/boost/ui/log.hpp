@@ -16,12 +16,60 @@
 
 #include <boost/ui/string.hpp>
 
-#include <sstream> // for std::ostringstream
+#include <boost/current_function.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <ostream>
+#include <streambuf>
+#include <string>
 
 namespace boost {
 namespace ui    {
 
+#ifndef DOXYGEN
+
+namespace detail {
+
+class log_binary_buffer;
+class log_site;
+
+// Location of the logging macro call site, its strings are literals,
+// so their addresses identify the call site
+struct log_literal_site
+{
+    log_literal_site(const char* f, int l, const char* n) : file(f), line(l), fn(n) {}
+
+    const char* file;
+    int line;
+    const char* fn;
+};
+
+// Collects narrow output of a value into fixed buffer without heap allocations
+class BOOST_UI_DECL log_streambuf : public std::streambuf
+{
+public:
+    log_streambuf() { setp(m_buffer, m_buffer + sizeof m_buffer); }
+
+    bool empty() const { return pbase() == pptr() && m_overflow.empty(); }
+
+    void append_to(uistring& str);
+    void append_to(log_binary_buffer& buf);
+
+protected:
+    virtual int_type overflow(int_type ch);
+
+private:
+    char m_buffer[256];
+    std::string m_overflow;
+};
+
+} // namespace detail
+
+#endif
+
 /// @brief Logging stream class with output into provided @ref uistring
+/// @details Numbers and strings are appended into the string directly,
+/// so logging doesn't allocate memory when the string has enough capacity.
 /// @ingroup log
 
 class BOOST_UI_DECL log_string
@@ -40,29 +88,47 @@ public:
     log_string& noquotes() { return quotes(false); }
     /// @}
 
-    /// Logs caller location in the source code
+    /// @brief Logs caller location in the source code
+    /// @details Location string is formatted once per call site,
+    /// strings are compared by contents, so they don't need to be literals
     log_string& location(const char* file, int line = -1, const char* fn = NULL);
 
+#ifndef DOXYGEN
+    log_string& location(const detail::log_literal_site& site);
+#endif
+
     ///@{ Logs value
 #ifndef BOOST_UI_NO_CAST_FROM_ASCII
     log_string& operator<<(char value);
-    log_string& operator<<(const char* value)
-        { return operator<<(std::string(value)); }
+    log_string& operator<<(const char* value);
     log_string& operator<<(const std::string& value);
 #endif
     log_string& operator<<(wchar_t value);
-    log_string& operator<<(const wchar_t* value)
-        { return operator<<(std::wstring(value)); }
+    log_string& operator<<(const wchar_t* value);
     log_string& operator<<(const std::wstring& value);
     log_string& operator<<(const uistring& value);
 
+    log_string& operator<<(bool value);
+    log_string& operator<<(short value);
+    log_string& operator<<(unsigned short value);
+    log_string& operator<<(int value);
+    log_string& operator<<(unsigned int value);
+    log_string& operator<<(long value);
+    log_string& operator<<(unsigned long value);
+    log_string& operator<<(long long value);
+    log_string& operator<<(unsigned long long value);
+    log_string& operator<<(float value);
+    log_string& operator<<(double value);
+    log_string& operator<<(long double value);
+
 #ifndef BOOST_UI_NO_CAST_FROM_ASCII
     template <class T>
     log_string& operator<<(const T& value)
     {
-        std::ostringstream ss;
-        ss << std::boolalpha << value;
-        raw(ss.str());
+        detail::log_streambuf buf;
+        std::ostream os(&buf);
+        os << std::boolalpha << value;
+        raw(buf);
         return *this;
     }
 #endif
@@ -71,21 +137,68 @@ public:
     /// Logs string without quotes
     log_string& raw(const uistring& value);
 
+protected:
+#ifndef DOXYGEN
+    const uistring& buffer() const { return m_string; }
+
+    detail::log_binary_buffer* binary() const { return m_binary; }
+    void binary(detail::log_binary_buffer* buf) { m_binary = buf; }
+
+    const detail::log_site* site() const { return m_site; }
+#endif
+
 private:
+    log_string& append_location(const detail::log_site& site);
     void append_space();
+    void append_narrow(const char* str, std::size_t length);
+    void append_wide(const wchar_t* str, std::size_t length);
+    void raw(detail::log_streambuf& buf);
+
+    template <class T>
+    log_string& append_integer(T value);
+
+    template <class T>
+    log_string& append_floating(T value);
 
     uistring& m_string;
+    detail::log_binary_buffer* m_binary;
+    const detail::log_site* m_site;
     bool m_spaces;
     bool m_quotes;
 };
 
+///@{ @brief Severity of log messages, from the most severe one
+/// @ingroup log
+#define BOOST_UI_LOG_LEVEL_FATAL   0
+#define BOOST_UI_LOG_LEVEL_ERROR   1
+#define BOOST_UI_LOG_LEVEL_WARNING 2
+#define BOOST_UI_LOG_LEVEL_INFO    3
+#define BOOST_UI_LOG_LEVEL_VERBOSE 4
+#define BOOST_UI_LOG_LEVEL_DEBUG   5
+#define BOOST_UI_LOG_LEVEL_TRACE   6
+///@}
+
+#ifndef BOOST_UI_LOG_MIN_LEVEL
+/// @brief Minimal severity of messages that are compiled in
+/// @details Logging macros with less severe level compile to nothing.
+/// Debug and trace messages are removed from release builds by default.
+/// @ingroup log
+#ifdef NDEBUG
+#define BOOST_UI_LOG_MIN_LEVEL BOOST_UI_LOG_LEVEL_VERBOSE
+#else
+#define BOOST_UI_LOG_MIN_LEVEL BOOST_UI_LOG_LEVEL_TRACE
+#endif
+#endif
+
 /// @brief Logging stream class
+/// @details Each thread reuses its own output buffers,
+/// so logging doesn't allocate memory in the steady state.
 /// @ingroup log
 
-class BOOST_UI_DECL log : public log_string
+class BOOST_UI_DECL log : public log_string, private boost::noncopyable
 {
 public:
-    log() : log_string(m_string), m_level(debug_level) {}
+    log();
     ~log();
 
     class fatal;
@@ -96,28 +209,182 @@ public:
     class debug;
     class trace;
 
+    /// @brief Sets minimal severity of logged messages at runtime
+    /// @details Accepts one of BOOST_UI_LOG_LEVEL_* values.
+    /// Fatal messages are always logged.
+    static void min_level(int level);
+
+    /// Returns minimal severity of logged messages
+    static int min_level();
+
+    /// Checks whether messages of @a level severity are logged
+    static bool enabled(int level);
+
+    /// @brief Checks whether message of @a level severity from the call site is logged
+    /// @details Takes token from the rate limit bucket of the call site.
+    static bool enabled(int level, const char* file, int line, const char* fn);
+
+#ifndef DOXYGEN
+    static bool enabled(int level, const detail::log_literal_site& site);
+#endif
+
+    /// @brief Limits count of messages of @a level severity from each call site
+    /// @details Each call site has token bucket that holds up to @a burst
+    /// messages and is refilled with @a per_second rate.
+    /// Messages without tokens aren't formatted, their count is logged
+    /// with the next passed message from the same call site.
+    /// Zero @a per_second removes the limit.
+    /// @see <a href="http://en.wikipedia.org/wiki/Token_bucket">Token bucket (Wikipedia)</a>
+    static void rate_limit(int level, double per_second, unsigned burst = 1);
+
+    /// @brief Collapses repeated messages of @a level severity from each call site
+    /// @details Message that is the same as the previous message
+    /// from the same call site isn't logged; "Last message repeated N times"
+    /// is logged before the next different message instead,
+    /// or by flush_repeats() that @ref async_log also calls every second.
+    static void collapse_repeats(int level, bool collapse = true);
+
+    /// @brief Logs "Last message repeated N times" notices of all call sites
+    /// that have collapsed messages which weren't reported yet
+    /// @details Called by async_log::flush() and async_log::stop().
+    static void flush_repeats();
+
+    /// Returns count of messages that were suppressed by rate limits
+    static unsigned long long rate_limited_count();
+
+    /// Returns count of messages that were collapsed as repeated
+    static unsigned long long repeated_count();
+
 protected:
 #ifndef DOXYGEN
     enum level_values
     {
-        fatal_level, error_level, warning_level, info_level,
-        verbose_level, debug_level, trace_level
+        fatal_level   = BOOST_UI_LOG_LEVEL_FATAL,
+        error_level   = BOOST_UI_LOG_LEVEL_ERROR,
+        warning_level = BOOST_UI_LOG_LEVEL_WARNING,
+        info_level    = BOOST_UI_LOG_LEVEL_INFO,
+        verbose_level = BOOST_UI_LOG_LEVEL_VERBOSE,
+        debug_level   = BOOST_UI_LOG_LEVEL_DEBUG,
+        trace_level   = BOOST_UI_LOG_LEVEL_TRACE
     };
 
-    log(level_values level) : log_string(m_string), m_level(level) {}
+    log(level_values level);
 #endif
 
 private:
+    static uistring& acquire_buffer();
+    void release_buffers();
+    void init();
     void flush();
+    bool check_site();
 
-    uistring m_string;
     level_values m_level;
+
+#ifndef DOXYGEN
+    friend class async_log_detail;
+#endif
+};
+
+/// @brief Asynchronous backend for @ref log
+/// @details While the backend is running, messages are pushed into
+/// the lock-free ring buffer of the calling thread as fixed-size records,
+/// and a dedicated thread formats and delivers them.
+/// Messages that don't fit into the full ring buffer are dropped and counted.
+/// Fatal messages wait until all previously logged messages are delivered.
+/// Start and stop the backend from the UI thread.
+/// @see <a href="http://en.wikipedia.org/wiki/Circular_buffer">Circular buffer (Wikipedia)</a>
+/// @ingroup log
+
+class BOOST_UI_DECL async_log
+{
+public:
+    /// Starts delivering messages into the native log
+    static bool start();
+
+    /// Starts appending messages into @a filename file
+    static bool start(const uistring& filename);
+
+    /// Delivers queued messages and stops the backend
+    static void stop();
+
+    /// Checks whether the backend is running
+    static bool running();
+
+    /// Waits until all messages that were logged before are delivered
+    static void flush();
+
+    /// Returns count of delivered messages
+    static unsigned long long delivered_count();
+
+    /// Returns count of messages that were dropped because ring buffer was full
+    static unsigned long long dropped_count();
+
+private:
+    async_log();
+};
+
+#ifndef DOXYGEN
+
+#define BOOST_UI_DETAIL_LOG_SITE \
+    ::boost::ui::detail::log_literal_site(__FILE__, __LINE__, BOOST_CURRENT_FUNCTION)
+
+// Arguments of disabled and rate limited messages aren't evaluated
+#define BOOST_UI_DETAIL_LOG(level, type) \
+    if ( (level) > BOOST_UI_LOG_MIN_LEVEL || \
+         !::boost::ui::log::enabled(level, BOOST_UI_DETAIL_LOG_SITE) ) {} else \
+        ::boost::ui::log::type().location(BOOST_UI_DETAIL_LOG_SITE)
+
+#endif
+
+///@{ @brief Logs current file, line and function with specified severity
+/// @details Streamed arguments are evaluated only if the severity is enabled
+/// and the call site isn't rate limited
+/// @relates boost::ui::log
+/// @ingroup log
+#define BOOST_UI_LOG_FATAL   BOOST_UI_DETAIL_LOG(BOOST_UI_LOG_LEVEL_FATAL,   fatal)
+#define BOOST_UI_LOG_ERROR   BOOST_UI_DETAIL_LOG(BOOST_UI_LOG_LEVEL_ERROR,   error)
+#define BOOST_UI_LOG_WARNING BOOST_UI_DETAIL_LOG(BOOST_UI_LOG_LEVEL_WARNING, warning)
+#define BOOST_UI_LOG_INFO    BOOST_UI_DETAIL_LOG(BOOST_UI_LOG_LEVEL_INFO,    info)
+#define BOOST_UI_LOG_VERBOSE BOOST_UI_DETAIL_LOG(BOOST_UI_LOG_LEVEL_VERBOSE, verbose)
+#define BOOST_UI_LOG_DEBUG   BOOST_UI_DETAIL_LOG(BOOST_UI_LOG_LEVEL_DEBUG,   debug)
+#define BOOST_UI_LOG_TRACE   BOOST_UI_DETAIL_LOG(BOOST_UI_LOG_LEVEL_TRACE,   trace)
+///@}
+
+/// @brief Binary backend for @ref log
+/// @details While the backend is running, messages except fatal ones are
+/// written into the memory-mapped file of fixed size without text formatting:
+/// as timestamp, level, call site id and raw bytes of arguments.
+/// File, line and function of each call site are written once per file.
+/// Messages that don't fit into the file are dropped and counted.
+/// Use the log_decode tool to convert the file into text.
+/// @ingroup log
+
+class BOOST_UI_DECL binary_log
+{
+public:
+    /// @brief Starts writing messages into @a filename file
+    /// @details The file is truncated and resized to @a capacity bytes
+    static bool start(const uistring& filename,
+                      std::size_t capacity = 64 * 1024 * 1024);
+
+    /// Stops writing messages and flushes the file
+    static void stop();
+
+    /// Checks whether the backend is running
+    static bool running();
+
+    /// @brief Returns count of messages that were dropped because file was full
+    /// or the backend was stopped while they were logged
+    static unsigned long long dropped_count();
+
+private:
+    binary_log();
 };
 
-/// @brief Logs current file, line and function
+/// @brief Logs current file, line and function into debug log
 /// @relates boost::ui::log
 /// @ingroup log
-#define BOOST_UI_LOG ::boost::ui::log().location(__FILE__, __LINE__, BOOST_CURRENT_FUNCTION)
+#define BOOST_UI_LOG BOOST_UI_LOG_DEBUG
 
 /// @brief Shows error and abort immediately
 /// @ingroup log
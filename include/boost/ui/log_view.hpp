@@ -0,0 +1,88 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file log_view.hpp Log viewer widget
+
+#ifndef BOOST_UI_LOG_VIEW_HPP
+#define BOOST_UI_LOG_VIEW_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/widget.hpp>
+#include <boost/ui/log.hpp>
+
+namespace boost {
+namespace ui    {
+
+/// @brief Widget that shows the latest log messages
+/// @details Messages are stored in the ring buffer of fixed capacity,
+/// the oldest ones are overwritten. Only visible rows are rendered,
+/// so appending a message takes constant time regardless of count of messages.
+/// Messages can be appended from any thread: they are queued without locks
+/// and are shown once per frame. Up to 1024 messages are queued per frame,
+/// count of further ones is shown instead of them.
+/// @see <a href="http://en.wikipedia.org/wiki/Circular_buffer">Circular buffer (Wikipedia)</a>
+/// @ingroup log
+
+class BOOST_UI_DECL log_view : public widget
+{
+public:
+    /// Unsigned integral type
+    typedef std::size_t size_type;
+
+    log_view() {}
+
+    ///@{ Creates log_view widget that stores up to @a capacity messages
+    explicit log_view(widget& parent, size_type capacity = 10000)
+        { create(parent, capacity); }
+    log_view& create(widget& parent, size_type capacity = 10000);
+    ///@}
+
+    /// @brief Appends message with BOOST_UI_LOG_LEVEL_* severity
+    /// @details Can be called from any thread
+    log_view& append(int level, const uistring& text);
+
+    /// @brief Shows messages that are logged by @ref log
+    /// @details Messages that are written by @ref binary_log aren't shown
+    log_view& capture(bool enable = true);
+
+    /// Shows messages of @a level severity and more severe ones only
+    log_view& min_level(int level);
+
+    /// Returns minimal severity of shown messages
+    int min_level() const;
+
+    /// @brief Shows messages that contain @a text only
+    /// @details Search is case sensitive. Typing more characters
+    /// searches among already found messages. Empty text shows all messages.
+    log_view& search(const uistring& text);
+
+    /// Returns searched text
+    uistring search() const;
+
+    /// Removes all messages
+    void clear();
+
+    /// Returns count of stored messages
+    size_type size() const;
+
+    /// Returns count of shown messages
+    size_type shown_count() const;
+
+private:
+    class native_impl;
+    class detail_impl;
+    detail_impl* get_impl();
+    const detail_impl* get_impl() const;
+};
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_LOG_VIEW_HPP
@@ -9,25 +9,61 @@
 #include <boost/ui/native/config.hpp>
 #include <boost/ui/native/widget.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
 #include <wx/window.h>
 
 namespace boost  {
 namespace ui     {
 namespace native {
 
+// Set while ui::event_trace is running
+BOOST_UI_DECL extern boost::atomic<bool> g_event_trace_running;
+
+inline bool event_trace_running()
+{
+    return g_event_trace_running.load(boost::memory_order_relaxed);
+}
+
+// Returns microseconds of monotonic clock
+BOOST_UI_DECL boost::uint64_t event_trace_now();
+
+// Records one handler invocation into ui::event_trace
+class BOOST_UI_DECL event_trace_scope : private boost::noncopyable
+{
+public:
+    // Native event handler, queue latency is taken from event timestamp
+    event_trace_scope(const void* key, wxEvtHandler* handler, const wxEvent& event);
+
+    // Function that was queued at @a enqueued time of event_trace_now()
+    event_trace_scope(const void* key, const char* name, boost::uint64_t enqueued);
+
+    ~event_trace_scope();
+
+private:
+    std::size_t m_handler;
+    unsigned m_generation;
+    boost::uint64_t m_begin;
+    boost::int64_t m_queue_latency;
+};
+
+// Filter type that lets compiler remove filtering
 template <class NativeEvent>
 class empty_filter
 {
 public:
-    bool operator()(NativeEvent& wxevent) { return true; }
+    bool operator()(NativeEvent&) { return true; }
 };
 
-template <class NativeEvent>
+// Stores concrete handler and filter types without type erasure,
+// so dispatching costs one indirect call of wxWidgets only
+template <class NativeEvent, class Handler, class Filter>
 class event_functor
 {
 public:
-    event_functor(const boost::function<void()>& handler,
-                  const boost::function<bool(NativeEvent&)>& filter)
+    event_functor(const Handler& handler, const Filter& filter)
         : m_handler(handler), m_filter(filter)
     {}
 
@@ -42,30 +78,40 @@ public:
     }
 
 private:
-    const boost::function<void()> m_handler;
-    const boost::function<bool(NativeEvent&)> m_filter;
+    Handler m_handler;
+    Filter m_filter;
 };
 
-
-template <class EventTag>
+template <class EventTag, class Handler, class Filter>
 void bind_helper(widget& w, EventTag eventType,
-                 const boost::function<void()>& handler,
-                 const boost::function<bool(typename EventTag::EventClass&)>& filter
-                     = empty_filter<typename EventTag::EventClass>())
+                 const Handler& handler, const Filter& filter)
 {
     wxWindow* impl = from_widget(w);
     wxCHECK_RET(impl, "Widget should be created");
 
     impl->Bind(eventType, event_functor<
-        typename EventTag::EventClass>(handler, filter));
+        typename EventTag::EventClass, Handler, Filter>(handler, filter));
 }
 
+template <class EventTag, class Handler>
+void bind_helper(widget& w, EventTag eventType, const Handler& handler)
+{
+    bind_helper(w, eventType, handler, empty_filter<typename EventTag::EventClass>());
+}
+
+// Converts native event into UI event
 template <class NativeEvent, class UIEvent>
 class event_functor_event
 {
 public:
-    event_functor_event(const boost::function<void(UIEvent&)>& handler,
-                        const boost::function<bool(NativeEvent&)>& filter)
+    static void init(UIEvent& uievent, NativeEvent& wxevent);
+};
+
+template <class NativeEvent, class UIEvent, class Handler, class Filter>
+class event_functor_ui_event
+{
+public:
+    event_functor_ui_event(const Handler& handler, const Filter& filter)
         : m_handler(handler), m_filter(filter)
     {}
 
@@ -77,28 +123,41 @@ public:
             return;
 
         UIEvent uievent;
-        init(uievent, wxevent);
+        event_functor_event<NativeEvent, UIEvent>::init(uievent, wxevent);
         m_handler(uievent);
     }
 
 private:
-    void init(UIEvent& uievent, NativeEvent& wxevent);
-
-    const boost::function<void(UIEvent&)> m_handler;
-    const boost::function<bool(NativeEvent&)> m_filter;
+    Handler m_handler;
+    Filter m_filter;
 };
 
-template <class EventTag, class UIEvent>
+// UIEvent is specified explicitly, handler is stored as its own type
+template <class UIEvent, class EventTag, class Handler, class Filter>
 void bind_event_helper(widget& w, EventTag eventType,
-                       const boost::function<void(UIEvent&)>& handler,
-                       const boost::function<bool(typename EventTag::EventClass&)>& filter
-                           = empty_filter<typename EventTag::EventClass>())
+                       const Handler& handler, const Filter& filter)
 {
     wxWindow* impl = from_widget(w);
     wxCHECK_RET(impl, "Widget should be created");
 
-    impl->Bind(eventType, event_functor_event<
-        typename EventTag::EventClass, UIEvent>(handler, filter));
+    impl->Bind(eventType, event_functor_ui_event<
+        typename EventTag::EventClass, UIEvent, Handler, Filter>(handler, filter));
+}
+
+template <class UIEvent, class EventTag, class Handler>
+void bind_event_helper(widget& w, EventTag eventType, const Handler& handler)
+{
+    bind_event_helper<UIEvent>(w, eventType, handler,
+                               empty_filter<typename EventTag::EventClass>());
+}
+
+// Deduces UIEvent from handler that crossed the library boundary
+template <class EventTag, class UIEvent>
+void bind_event_helper(widget& w, EventTag eventType,
+                       const boost::function<void(UIEvent&)>& handler)
+{
+    bind_event_helper<UIEvent>(w, eventType, handler,
+                               empty_filter<typename EventTag::EventClass>());
 }
 
 } // namespace native
@@ -18,6 +18,7 @@ namespace ui     {
 namespace native {
 
 wxString from_uistring(const uistring& str);
+const wxString& from_uistring_ref(const uistring& str);
 uistring to_uistring(const wxString& str);
 wxArrayString from_vector_uistring(const std::vector<uistring>& arr);
 
@@ -14,8 +14,11 @@
 #pragma once
 #endif
 
+#include <boost/ui/cancellation.hpp>
 #include <boost/ui/widget.hpp>
 
+#include <boost/shared_ptr.hpp>
+
 namespace boost {
 namespace ui    {
 
@@ -95,6 +98,45 @@ public:
     ///@}
 };
 
+/// @brief Reports progress of background task to the progress bar
+/// @details report() can be called from any thread as often as needed,
+/// progress bar is updated in the UI thread at most once per frame
+/// with the latest reported value.
+/// Reports are ignored after the progress bar is destroyed.
+/// Usage example:
+/// @code
+/// ui::progress_reporter reporter(bar);
+/// pool.post(reporter.token(), [reporter]
+/// {
+///     for ( int i = 0; i <= 100 && !reporter.token().cancelled(); i++ )
+///     {
+///         step(i);
+///         reporter.report(i);
+///     }
+/// });
+/// @endcode
+/// @see thread_pool
+/// @ingroup info
+
+class BOOST_UI_DECL progress_reporter
+{
+public:
+    /// @brief Creates reporter for the @a bar progress bar
+    /// @details Should be called from the UI thread
+    explicit progress_reporter(progress_bar& bar);
+
+    /// @brief Queues update of the progress bar, can be called from any thread
+    /// @details @a value is clamped to the progress bar range
+    void report(progress_bar::value_type value) const;
+
+    /// Returns token that is cancelled when the progress bar is destroyed
+    cancellation_token token() const;
+
+private:
+    class impl;
+    boost::shared_ptr<impl> m_impl;
+};
+
 } // namespace ui
 } // namespace boost
 
@@ -0,0 +1,179 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file remote.hpp Widget proxy that can be modified from any thread
+
+#ifndef BOOST_UI_REMOTE_HPP
+#define BOOST_UI_REMOTE_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/widget.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace boost {
+namespace ui    {
+
+#ifndef DOXYGEN
+
+namespace detail {
+
+// Type independent part of remote<W>, widget copy is owned by state
+// that is released in the UI thread
+class BOOST_UI_DECL remote_base
+{
+public:
+    enum property
+    {
+        property_move,
+        property_resize,
+        property_enable,
+        property_show,
+        property_tooltip,
+        property_text,
+        property_value,
+        property_count
+    };
+
+protected:
+    explicit remote_base(widget* w);
+
+    void set_raw(property p, const boost::function<void(widget&)>& fn);
+    void set_raw(const void* key, const boost::function<void(widget&)>& fn);
+
+private:
+    class impl;
+    boost::shared_ptr<impl> m_impl;
+};
+
+} // namespace detail
+
+#endif
+
+/// @brief Widget proxy which properties can be set from any thread
+/// @details Widget methods should be called from the UI thread only,
+/// even copying of the widget isn't thread safe.
+/// Proxy is created in the UI thread, its copies can be used from any thread.
+/// Setters record changes that are applied together in the UI thread
+/// by one call_async() call. If property is set several times
+/// before it is applied, only the last value is applied.
+/// Changes are ignored after native widget is destroyed.
+/// Usage example:
+/// @code
+/// ui::remote<ui::label> status(status_label);
+/// pool.post([status]() mutable
+/// {
+///     status.text("Loading...").show();
+///     load();
+///     status.text("Done");
+/// });
+/// @endcode
+/// @see call_async(), thread_pool
+/// @ingroup thread
+
+template <class W>
+class remote : private detail::remote_base
+{
+public:
+    /// @brief Creates proxy of the @a w widget
+    /// @details Should be called from the UI thread
+    explicit remote(W& w) : detail::remote_base(new W(w)) {}
+
+    /// Moves widget to specified position
+    remote& move(coord_type x, coord_type y)
+    {
+        set_raw(property_move, boost::bind(&remote::apply_move, _1, x, y));
+        return *this;
+    }
+
+    /// Changes widget size to specified values
+    remote& resize(coord_type width, coord_type height)
+    {
+        set_raw(property_resize, boost::bind(&remote::apply_resize, _1, width, height));
+        return *this;
+    }
+
+    ///@{ Enables or disables widget
+    remote& enable(bool do_enable = true)
+    {
+        set_raw(property_enable, boost::bind(&remote::apply_enable, _1, do_enable));
+        return *this;
+    }
+    remote& disable() { return enable(false); }
+    ///@}
+
+    ///@{ Shows or hides widget
+    remote& show(bool do_show = true)
+    {
+        set_raw(property_show, boost::bind(&remote::apply_show, _1, do_show));
+        return *this;
+    }
+    remote& hide() { return show(false); }
+    ///@}
+
+    /// Sets tooltip text
+    remote& tooltip(const uistring& text)
+    {
+        set_raw(property_tooltip, boost::bind(&remote::apply_tooltip, _1, text));
+        return *this;
+    }
+
+    /// Calls W::text(@a text), for widgets that have text
+    remote& text(const uistring& text)
+    {
+        set_raw(property_text, boost::bind(&remote::apply_text, _1, text));
+        return *this;
+    }
+
+    /// Calls W::value(@a value), for widgets that have value, such as progress_bar
+    template <class T>
+    remote& value(const T& value)
+    {
+        set_raw(property_value, boost::bind(&remote::apply_value<T>, _1, value));
+        return *this;
+    }
+
+    /// @brief Queues @a f(W&) call in the UI thread
+    /// @details Previously queued function with the same @a key is replaced.
+    /// Function and its bound arguments should be copyable from any thread.
+    template <class F>
+    remote& set(const void* key, F f)
+    {
+        set_raw(key, boost::bind(&remote::apply_function<F>, _1, f));
+        return *this;
+    }
+
+private:
+    static void apply_move(widget& w, coord_type x, coord_type y)
+        { w.move(x, y); }
+    static void apply_resize(widget& w, coord_type width, coord_type height)
+        { w.resize(width, height); }
+    static void apply_enable(widget& w, bool do_enable)
+        { w.enable(do_enable); }
+    static void apply_show(widget& w, bool do_show)
+        { w.show(do_show); }
+    static void apply_tooltip(widget& w, const uistring& text)
+        { w.tooltip(text); }
+    static void apply_text(widget& w, const uistring& text)
+        { static_cast<W&>(w).text(text); }
+    template <class T>
+    static void apply_value(widget& w, const T& value)
+        { static_cast<W&>(w).value(value); }
+    template <class F>
+    static void apply_function(widget& w, F& f)
+        { f(static_cast<W&>(w)); }
+};
+
+} // namespace ui
+} // namespace boost
+
+#endif // BOOST_UI_REMOTE_HPP
@@ -15,12 +15,63 @@
 #endif
 
 #include <sstream>
+#include <cwchar> // for std::wcslen()
 
 #include <boost/ui/string.hpp>
+#include <boost/ui/detail/to_chars.hpp>
 
 namespace boost {
 namespace ui    {
 
+#ifndef DOXYGEN
+
+namespace detail {
+
+// Stream buffer that appends characters directly into uistring
+class uistring_streambuf : public std::wstreambuf
+{
+public:
+    explicit uistring_streambuf(uistring& str) : m_string(str)
+        { setp(m_buffer, m_buffer + buffer_size); }
+    ~uistring_streambuf() { flush_buffer(); }
+
+protected:
+    virtual int_type overflow(int_type ch)
+    {
+        flush_buffer();
+        if ( !traits_type::eq_int_type(ch, traits_type::eof()) )
+        {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+    virtual int sync()
+    {
+        flush_buffer();
+        return 0;
+    }
+
+private:
+    void flush_buffer()
+    {
+        m_string.append(pbase(), pptr() - pbase());
+        setp(m_buffer, m_buffer + buffer_size);
+    }
+
+    enum { buffer_size = 64 };
+
+    uistring& m_string;
+    wchar_t m_buffer[buffer_size];
+};
+
+BOOST_UI_DECL const char* append_format_text(uistring& str, const char* fmt);
+BOOST_UI_DECL const wchar_t* append_format_text(uistring& str, const wchar_t* fmt);
+
+} // namespace detail
+
+#endif
+
 /// @brief Output string stream that collects data for UI
 /// @ingroup helper
 
@@ -28,10 +79,38 @@ class BOOST_UI_DECL uiostringstream
 {
 public:
     /// Creates empty stream
-    uiostringstream() {}
+    uiostringstream() : m_format(chars_format::general), m_precision(-1) {}
 
     /// @brief Creates stream and adds @a value to it
-    uiostringstream(const uistring& value) : m_buffer(value) {}
+    uiostringstream(const uistring& value)
+        : m_buffer(value), m_format(chars_format::general), m_precision(-1) {}
+
+    /// @brief Sets notation of the floating-point values
+    uiostringstream& format(chars_format fmt) { m_format = fmt; return *this; }
+
+    /// @brief Returns notation of the floating-point values
+    chars_format format() const { return m_format; }
+
+    /// @brief Sets precision of the floating-point values
+    /// @details For chars_format::fixed and chars_format::scientific
+    /// it is count of digits after decimal point,
+    /// for chars_format::general it is count of significant digits.
+    /// Negative value means the shortest representation
+    /// that is parsed back to the same value
+    uiostringstream& precision(int value) { m_precision = value; return *this; }
+
+    /// @brief Returns precision of the floating-point values
+    /// @details Count of digits after decimal point for fixed and scientific
+    /// notations or count of significant digits for general notation
+    int precision() const { return m_precision; }
+
+    /// @brief Reserves storage for at least @a new_cap characters
+    /// to avoid reallocations while data is inserted
+    uiostringstream& reserve(uistring::size_type new_cap)
+    {
+        m_buffer.reserve(new_cap);
+        return *this;
+    }
 
     /// @brief Process stream manipulator
     uiostringstream& operator<<(boost::ui::uiostringstream& (*func)(boost::ui::uiostringstream&))
@@ -42,49 +121,50 @@ public:
     ///@{ @brief Inserts data into stream
     uiostringstream& operator<<(short value)
     {
-        m_buffer += to_uistring(value);
+        detail::append_integer(m_buffer, value);
         return *this;
     }
     uiostringstream& operator<<(unsigned short value)
     {
-        m_buffer += to_uistring(value);
+        detail::append_integer(m_buffer, value);
         return *this;
     }
     uiostringstream& operator<<(int value)
     {
-        m_buffer += to_uistring(value);
+        detail::append_integer(m_buffer, value);
         return *this;
     }
     uiostringstream& operator<<(unsigned int value)
     {
-        m_buffer += to_uistring(value);
+        detail::append_integer(m_buffer, value);
         return *this;
     }
     uiostringstream& operator<<(long value)
     {
-        m_buffer += to_uistring(value);
+        detail::append_integer(m_buffer, value);
         return *this;
     }
     uiostringstream& operator<<(unsigned long value)
     {
-        m_buffer += to_uistring(value);
+        detail::append_integer(m_buffer, value);
         return *this;
     }
     uiostringstream& operator<<(long long value)
     {
-        m_buffer += to_uistring(value);
+        detail::append_integer(m_buffer, value);
         return *this;
     }
     uiostringstream& operator<<(unsigned long long value)
     {
-        m_buffer += to_uistring(value);
+        detail::append_integer(m_buffer, value);
         return *this;
     }
     uiostringstream& operator<<(float value);
     uiostringstream& operator<<(double value);
+    uiostringstream& operator<<(long double value);
     uiostringstream& operator<<(bool value)
     {
-        m_buffer += ascii(value ? "1" : "0");
+        m_buffer.push_back(value ? L'1' : L'0');
         return *this;
     }
     uiostringstream& operator<<(char value)
@@ -109,12 +189,12 @@ public:
     }
     uiostringstream& operator<<(const wchar_t* value)
     {
-        m_buffer += value;
+        m_buffer.append(value, std::wcslen(value));
         return *this;
     }
     uiostringstream& operator<<(const std::wstring& value)
     {
-        m_buffer += value;
+        m_buffer.append(value.data(), value.size());
         return *this;
     }
 #ifndef BOOST_NO_CXX11_CHAR16_T
@@ -154,24 +234,107 @@ public:
     template <class T>
     uiostringstream& operator<<(const T& value)
     {
-        std::wostringstream ss;
-        ss << value;
-        m_buffer += ss.str();
+        detail::uistring_streambuf buffer(m_buffer);
+        std::wostream os(&buffer);
+        os << value;
+        return *this;
+    }
+    ///@}
+
+    ///@{ @brief Inserts @a fmt format string replacing each "{}" placeholder
+    ///   with the next argument, "{{" and "}}" insert single braces.
+    ///   Narrow format string should be 7-bit ASCII encoded.
+#ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
+    template <class CharT, class T, class ...Args>
+    uiostringstream& append_format(const CharT* fmt, const T& value, const Args&... args)
+    {
+        fmt = detail::append_format_text(m_buffer, fmt);
+        if ( !fmt )
+            return *this;
+
+        *this << value;
+        return append_format(fmt, args...);
+    }
+#else
+    template <class CharT, class T1>
+    uiostringstream& append_format(const CharT* fmt, const T1& a1)
+    {
+        fmt = detail::append_format_text(m_buffer, fmt);
+        if ( !fmt )
+            return *this;
+
+        *this << a1;
+        return append_format(fmt);
+    }
+    template <class CharT, class T1, class T2>
+    uiostringstream& append_format(const CharT* fmt, const T1& a1, const T2& a2)
+    {
+        fmt = detail::append_format_text(m_buffer, fmt);
+        if ( !fmt )
+            return *this;
+
+        *this << a1;
+        return append_format(fmt, a2);
+    }
+    template <class CharT, class T1, class T2, class T3>
+    uiostringstream& append_format(const CharT* fmt, const T1& a1, const T2& a2, const T3& a3)
+    {
+        fmt = detail::append_format_text(m_buffer, fmt);
+        if ( !fmt )
+            return *this;
+
+        *this << a1;
+        return append_format(fmt, a2, a3);
+    }
+#endif
+    template <class CharT>
+    uiostringstream& append_format(const CharT* fmt)
+    {
+        // Placeholders without arguments are inserted as is
+        while ( fmt && *fmt )
+        {
+            fmt = detail::append_format_text(m_buffer, fmt);
+            if ( fmt )
+                m_buffer.append_ascii("{}", 2);
+        }
         return *this;
     }
     ///@}
 
     /// @brief Exchanges contents of the streams
-    void swap(uiostringstream& other) { m_buffer.swap(other.m_buffer); }
+    void swap(uiostringstream& other)
+    {
+        m_buffer.swap(other.m_buffer);
+        std::swap(m_format, other.m_format);
+        std::swap(m_precision, other.m_precision);
+    }
 
     /// @brief Returns collected data as a string
+#ifndef BOOST_NO_CXX11_REF_QUALIFIERS
+    uistring str() const & { return m_buffer; }
+
+    /// @brief Moves collected data out of the temporary stream
+    uistring str() && { return take(); }
+#else
     uistring str() const { return m_buffer; }
+#endif
+
+    /// @brief Moves collected data out of the stream without copying
+    /// and leaves the stream empty
+    uistring take()
+    {
+        uistring result;
+        result.swap(m_buffer);
+        return result;
+    }
 
     /// @brief Resets built-in collected data with @a value
     void str(const uistring& value) { m_buffer = value; }
 
 private:
     uistring m_buffer;
+    chars_format m_format;
+    int m_precision;
 };
 
 } // namespace ui
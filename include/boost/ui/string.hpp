@@ -16,6 +16,8 @@
 
 #include <string>
 
+#include <boost/core/scoped_enum.hpp>
+
 #ifndef BOOST_NO_CXX11_HDR_INITIALIZER_LIST
 #include <initializer_list>
 #endif
@@ -43,6 +45,16 @@
 namespace boost {
 namespace ui    {
 
+/// @brief Floating-point formatting options for @ref to_uistring()
+/// @ingroup helper
+BOOST_SCOPED_ENUM_DECLARE_BEGIN(chars_format)
+{
+    general,    ///< Shorter of fixed and scientific notations
+    fixed,      ///< Fixed-point notation
+    scientific  ///< Scientific notation with exponent
+}
+BOOST_SCOPED_ENUM_DECLARE_END(chars_format)
+
 /// @brief Helper class to convert string between UI and application logic only
 /// @ingroup helper
 
@@ -158,6 +170,7 @@ public:
     ///@{ Appends characters to the end of string
     uistring& append(const uistring& str);
     uistring& operator+=(const uistring& str) { return append(str); }
+    uistring& append(const wchar_t* str, size_type count);
 #ifndef BOOST_UI_NO_CAST_FROM_ASCII
     uistring& append(size_type count, char ch);
 #endif
@@ -216,6 +229,9 @@ public:
 #endif
     ///@}
 
+    /// Appends @a count 7-bit ASCII encoded characters to the end of string
+    uistring& append_ascii(const char* str, size_type count);
+
     ///@{ Appends character to the end of string
 #ifndef BOOST_UI_NO_CAST_FROM_ASCII
     void push_back(char ch);
@@ -258,6 +274,9 @@ public:
     /// Clears the contents
     void clear() BOOST_NOEXCEPT;
 
+    /// Reserves storage for at least @a new_cap characters
+    void reserve(size_type new_cap);
+
     /// Requests the removal of unused capacity
     void shrink_to_fit();
 
@@ -597,6 +616,16 @@ BOOST_UI_DECL uistring to_uistring(double value);
 BOOST_UI_DECL uistring to_uistring(long double value);
 ///@}
 
+///@{ @brief Converts floating-point value to @ref uistring
+///   using specified notation and count of digits after decimal point.
+///   Negative @a precision means the shortest representation
+///   that is parsed back to the same value.
+///   @relatesalso boost::ui::uistring
+BOOST_UI_DECL uistring to_uistring(float value, chars_format fmt, int precision = -1);
+BOOST_UI_DECL uistring to_uistring(double value, chars_format fmt, int precision = -1);
+BOOST_UI_DECL uistring to_uistring(long double value, chars_format fmt, int precision = -1);
+///@}
+
 /// @brief Returns hash of @ref uistring for boost::hash
 /// @relatesalso boost::ui::uistring
 BOOST_UI_DECL std::size_t hash_value(const uistring& value);
@@ -0,0 +1,126 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+/// @file text.hpp Large text class
+
+#ifndef BOOST_UI_TEXT_HPP
+#define BOOST_UI_TEXT_HPP
+
+#include <boost/ui/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include <boost/ui/string.hpp>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace boost {
+namespace ui    {
+
+/// @brief Text storage for very large documents
+/// @details Text is stored as a balanced tree of immutable chunks (rope),
+/// so append, insert and erase take logarithmic time
+/// and copies and substrings share chunks instead of copying characters.
+/// Positions are counted in wchar_t characters.
+/// @see <a href="http://en.wikipedia.org/wiki/Rope_(data_structure)">Rope (Wikipedia)</a>
+/// @ingroup helper
+
+class BOOST_UI_DECL uitext
+{
+public:
+    /// Unsigned integral type
+    typedef std::size_t size_type;
+
+    /// Special value that means all characters until the end of text
+    static const size_type npos = static_cast<size_type>(-1);
+
+    /// Creates empty text
+    uitext() {}
+
+    ///@{ @brief Creates text with @a str contents
+    /// @details Constructors are explicit, so string arguments
+    /// don't make uistring and uitext overloads ambiguous.
+    explicit uitext(const uistring& str);
+    explicit uitext(const wchar_t* str);
+    ///@}
+
+    /// Returns count of characters
+    size_type size() const BOOST_NOEXCEPT;
+
+    /// Checks whether the text is empty
+    bool empty() const BOOST_NOEXCEPT { return !m_root; }
+
+    /// Clears the contents
+    void clear() BOOST_NOEXCEPT { m_root.reset(); }
+
+    /// Returns character at @a pos position
+    wchar_t operator[](size_type pos) const;
+
+    ///@{ Appends string or other text to the end of text
+    uitext& append(const uistring& str);
+    uitext& append(const wchar_t* str, size_type count);
+    uitext& append(const uitext& other);
+    uitext& operator+=(const uistring& str) { return append(str); }
+    uitext& operator+=(const uitext& other) { return append(other); }
+    ///@}
+
+    ///@{ Inserts string or other text before @a pos position
+    uitext& insert(size_type pos, const uistring& str);
+    uitext& insert(size_type pos, const uitext& other);
+    ///@}
+
+    /// Removes @a count characters starting from @a pos position
+    uitext& erase(size_type pos, size_type count = npos);
+
+    /// Returns text that shares characters with this text
+    uitext substr(size_type pos, size_type count = npos) const;
+
+    /// Exchanges the contents of texts
+    void swap(uitext& other) BOOST_NOEXCEPT { m_root.swap(other.m_root); }
+
+    /// Returns text contents as a flat string
+    uistring str() const;
+
+    /// @brief Calls @a fn for each stored chunk of characters in order.
+    /// @details Allows to consume text incrementally without flat copy.
+    void for_each_chunk(const boost::function<void(const wchar_t*, size_type)>& fn) const;
+
+private:
+    class node;
+    typedef boost::shared_ptr<const node> node_ptr;
+
+    explicit uitext(const node_ptr& root) : m_root(root) {}
+
+    node_ptr m_root;
+
+#ifndef DOXYGEN
+    friend class uitext_detail;
+#endif
+};
+
+/// @brief Concatenates two texts
+/// @relatesalso boost::ui::uitext
+inline uitext operator+(const uitext& lhs, const uitext& rhs)
+{
+    uitext result(lhs);
+    result.append(rhs);
+    return result;
+}
+
+} // namespace ui
+} // namespace boost
+
+namespace std {
+
+/// @brief Specializes the std::swap algorithm
+/// @relatesalso boost::ui::uitext
+inline void swap(boost::ui::uitext& a, boost::ui::uitext& b) { a.swap(b); }
+
+} // namespace std
+
+#endif // BOOST_UI_TEXT_HPP
@@ -15,6 +15,7 @@
 #endif
 
 #include <boost/ui/widget.hpp>
+#include <boost/ui/text.hpp>
 
 namespace boost {
 namespace ui    {
@@ -34,6 +35,17 @@ public:
     /// Sets text into the editor
     text_box_base& text(const uistring& text);
 
+    /// @brief Sets large text into the editor
+    /// @details Chunks are copied directly into one native string,
+    /// without intermediate uistring.
+    text_box_base& text(const uitext& text);
+
+    ///@{ @brief Appends text to the end of the editor without resetting whole text
+    /// @details Edit handler is called once per call.
+    text_box_base& append_text(const uistring& text);
+    text_box_base& append_text(const uitext& text);
+    ///@}
+
     /// Returns text from the editor
     uistring text() const;
 
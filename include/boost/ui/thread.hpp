@@ -14,6 +14,9 @@
 #pragma once
 #endif
 
+#include <boost/ui/event_trace.hpp>
+
+#include <boost/cstdint.hpp>
 #include <boost/function.hpp>
 
 #ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
@@ -26,12 +29,27 @@ namespace ui     {
 #ifndef DOXYGEN
 
 namespace detail {
+
+// Node of the call_async() queue that is owned by caller,
+// so queuing it doesn't allocate memory
+struct async_item
+{
+    // Called once in the UI thread, can destroy the item
+    void (*call)(async_item* item);
+    async_item* next;
+};
+
+BOOST_UI_DECL void call_async(async_item* item);
 BOOST_UI_DECL void call_async(const boost::function<void()>& fn);
+BOOST_UI_DECL void call_async_latest(const void* key, const boost::function<void()>& fn);
 } // namespace detail
 
 #endif
 
 /// @brief Calls @a f in the idle time in UI thread. This function is thread safe.
+/// @details Functions are queued without locks. UI thread is woken up once
+/// per batch of functions that were queued before it started calling them.
+/// @see async_stats()
 /// @see <a href="http://en.wikipedia.org/wiki/Thread_safety">Thread safety (Wikipedia)</a>
 /// @ingroup thread
 
@@ -48,6 +66,65 @@ inline void call_async(const boost::function<void()>& fn)
 }
 #endif
 
+/// @brief Calls @a f in the idle time in UI thread,
+/// replacing function with the same @a key that wasn't called yet
+/// @details Only the latest function of a burst is called,
+/// for example of progress updates from a worker thread.
+/// @a key is usually address of the updated widget.
+/// This function is thread safe.
+/// Usage example:
+/// @code
+/// ui::call_async_latest(&bar, [&bar, percent] { bar.value(percent); });
+/// @endcode
+/// @see call_async()
+/// @ingroup thread
+
+#ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
+template <class F, class ...Args>
+void call_async_latest(const void* key, F&& f, Args&&... args)
+{
+    detail::call_async_latest(key,
+        std::bind(boost::forward<F>(f), boost::forward<Args>(args)...));
+}
+#else
+inline void call_async_latest(const void* key, const boost::function<void()>& fn)
+{
+    detail::call_async_latest(key, fn);
+}
+#endif
+
+/// @brief Statistics of the call_async() queue
+/// @ingroup thread
+struct async_queue_stats
+{
+    /// Count of queued functions that weren't called yet
+    std::size_t depth;
+
+    /// The highest count of queued functions
+    std::size_t max_depth;
+
+    /// Count of called functions
+    boost::uint64_t calls;
+
+    /// Count of batches, i.e. wakeups of UI thread
+    boost::uint64_t batches;
+
+    /// Count of functions replaced by call_async_latest()
+    boost::uint64_t superseded;
+
+    /// Durations of batch processing in microseconds
+    latency_histogram drain_time;
+};
+
+/// @brief Returns statistics of the call_async() queue
+/// @details Should be called from UI thread
+/// @ingroup thread
+BOOST_UI_DECL async_queue_stats async_stats();
+
+/// @brief Returns count of queued functions that weren't called yet
+/// @details This function is thread safe
+/// @ingroup thread
+BOOST_UI_DECL std::size_t async_queue_depth();
 
 } // namespace ui
 } // namespace boost
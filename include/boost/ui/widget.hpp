@@ -172,6 +172,20 @@ public:
     BOOST_UI_DETAIL_HANDLER_EVENT(mouse_wheel_event, widget, wheel_event);
     ///@}
 
+    ///@{ @brief Connects mouse handler that is called at most once per frame
+    /// @details Native events that come during the frame are merged:
+    /// the handler receives the latest position, count of merged events
+    /// and sum of wheel deltas.
+    BOOST_UI_DETAIL_HANDLER_EVENT(coalesced_mouse_move_event, widget, mouse_event);
+    BOOST_UI_DETAIL_HANDLER_EVENT(coalesced_mouse_wheel_event, widget, wheel_event);
+    ///@}
+
+    ///@{ @brief Connects mouse move handler that is called at most once per frame
+    /// and receives positions of all merged moves in mouse_event::history()
+    /// @details Use it to draw smooth lines by mouse.
+    BOOST_UI_DETAIL_HANDLER_EVENT(coalesced_mouse_history_event, widget, mouse_event);
+    ///@}
+
     /// Returns true only if native widget was created
     bool native_valid() const BOOST_NOEXCEPT { return native_handle() != NULL; }
 
@@ -234,6 +248,9 @@ private:
     void on_context_menu_event_raw(const boost::function<void(mouse_event&)>& handler);
     void on_mouse_wheel_raw(const boost::function<void()>& handler);
     void on_mouse_wheel_event_raw(const boost::function<void(wheel_event&)>& handler);
+    void on_coalesced_mouse_move_event_raw(const boost::function<void(mouse_event&)>& handler);
+    void on_coalesced_mouse_wheel_event_raw(const boost::function<void(wheel_event&)>& handler);
+    void on_coalesced_mouse_history_event_raw(const boost::function<void(mouse_event&)>& handler);
 
     detail::widget_detail_base* m_detail_impl;
     detail::shared_count m_shared_count;
@@ -8,20 +8,41 @@
 #include <boost/ui/native/config.hpp>
 
 #include <boost/ui/application.hpp>
+#include <boost/ui/idle.hpp>
+#include <boost/ui/interval.hpp>
+#include <boost/ui/log.hpp>
 #include <boost/ui/string.hpp>
 #include <boost/ui/native/string.hpp>
+#include <boost/ui/native/event.hpp>
 #include <boost/ui/detail/memcheck.hpp>
+#include <boost/ui/detail/timer_wheel.hpp>
 
 #include <boost/exception/get_error_info.hpp>
-#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/integer_traits.hpp>
 
+#include <algorithm>
+#include <climits>
 #include <sstream>
-#include <map>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#endif
 
 #include <wx/app.h>
 #include <wx/msgdlg.h>
 #include <wx/timer.h>
 
+#ifdef BOOST_NO_CXX11_HDR_CHRONO
+#if defined(__WINDOWS__)
+#include <wx/msw/wrapwin.h>
+#elif defined(__DARWIN__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+#endif
+
 #include <boost/ui/native/winmain.cpp>
 
 #if !wxCHECK_VERSION(3, 0, 0)
@@ -104,11 +125,13 @@ void show_exception(const char* where)
     show_exception_raw(ss.str(), "Unknown exception");
 }
 
-void safe_call(const boost::function<void()>& fn, const char* where)
+// Shows exception that is being handled, should be called from catch block only.
+// Keeps catch clauses out of the callers, so they only set up one try block
+void show_current_exception(const char* where)
 {
     try
     {
-        fn();
+        throw;
     }
     catch ( boost::exception& e )
     {
@@ -157,9 +180,11 @@ class boost_ui_app : public wxApp
     typedef wxApp        base_type;
 
 public:
+    boost_ui_app();
     virtual ~boost_ui_app();
     virtual bool OnInit() wxOVERRIDE;
     virtual int OnRun() wxOVERRIDE;
+    virtual int OnExit() wxOVERRIDE;
 
 #if wxUSE_CMDLINE_PARSER
     virtual bool OnCmdLineError(wxCmdLineParser& WXUNUSED(parser)) wxOVERRIDE
@@ -172,31 +197,58 @@ public:
                                   wxEventFunctor& functor,
                                   wxEvent& event) const wxOVERRIDE;
 
-    void on_timeout(int milliseconds, const boost::function<void()>& fn);
+    boost::ui::timeout_handle on_timeout(int milliseconds,
+                                         const boost::function<void()>& fn);
+    bool cancel_timeout(boost::uint64_t id);
+    bool timeout_pending(boost::uint64_t id) const;
 
 private:
 #if wxUSE_TIMER
     void on_timer(wxTimerEvent& event);
+    void restart_timer();
+
+    // Restarts native timer even if timeout function throws exception
+    class restart_guard
+    {
+    public:
+        explicit restart_guard(boost_ui_app& app) : m_app(app) {}
+        ~restart_guard()
+        {
+            m_app.restart_timer();
+        }
+
+    private:
+        boost_ui_app& m_app;
+    };
 
-    typedef std::map< int, std::pair< wxTimer*, boost::function<void()> > > timers_type;
-    timers_type m_timers;
+    // All timeouts share one native timer that is started
+    // for the nearest expiry time of the timer wheel
+    wxTimer* m_timer;
+    boost::ui::detail::timer_wheel m_wheel;
+    boost::uint64_t m_timer_expiry;
 #endif
 
     void OnRunHere(int &result);
-
-    void CallEventHandlerBase(wxEvtHandler* handler,
-                              wxEventFunctor& functor,
-                              wxEvent& event) const
-    {
-        base_type::CallEventHandler(handler, functor, event);
-    }
 };
 
+#if wxUSE_TIMER
+
+const boost::uint64_t no_expiry = boost::integer_traits<boost::uint64_t>::const_max;
+
+#endif
+
+boost_ui_app::boost_ui_app()
+#if wxUSE_TIMER
+    : m_timer(NULL), m_wheel(boost::ui::detail::timeout_now()),
+      m_timer_expiry(no_expiry)
+#endif
+{
+}
+
 boost_ui_app::~boost_ui_app()
 {
 #if wxUSE_TIMER
-    for ( timers_type::iterator iter = m_timers.begin(); iter != m_timers.end(); ++iter )
-        delete iter->second.first;
+    delete m_timer;
 #endif
 }
 
@@ -222,42 +274,123 @@ void boost_ui_app::OnRunHere(int &result)
 int boost_ui_app::OnRun()
 {
     int result = EXIT_FAILURE;
-    safe_call(boost::bind(&this_type::OnRunHere, this,
-                          boost::ref(result)),
-              " in the main Boost.UI function, terminating");
+    try
+    {
+        OnRunHere(result);
+    }
+    catch ( ... )
+    {
+        show_current_exception(" in the main Boost.UI function, terminating");
+    }
     return result;
 }
 
+int boost_ui_app::OnExit()
+{
+    // Timer threads queue functions that can't be called after exit
+    boost::ui::detail::cancel_intervals();
+    boost::ui::detail::clear_idle_tasks();
+
+    // Deliver queued log messages while wxWidgets is still alive
+    boost::ui::async_log::stop();
+    boost::ui::binary_log::stop();
+
+    return base_type::OnExit();
+}
+
 void boost_ui_app::CallEventHandler(wxEvtHandler* handler,
                                     wxEventFunctor& functor,
                                     wxEvent& event) const
 {
-    safe_call(boost::bind(&this_type::CallEventHandlerBase, this,
-                          handler, boost::ref(functor), boost::ref(event)),
-              " in a Boost.UI event handler");
+    // Called for each event, so it shouldn't allocate or type-erase anything
+    try
+    {
+        if ( boost::ui::native::event_trace_running() )
+        {
+            boost::ui::native::event_trace_scope scope(&functor, handler, event);
+            base_type::CallEventHandler(handler, functor, event);
+        }
+        else
+            base_type::CallEventHandler(handler, functor, event);
+    }
+    catch ( ... )
+    {
+        show_current_exception(" in a Boost.UI event handler");
+    }
 }
 
-void boost_ui_app::on_timeout(int milliseconds, const boost::function<void()>& fn)
+boost::ui::timeout_handle boost_ui_app::on_timeout(int milliseconds,
+                                                   const boost::function<void()>& fn)
 {
     if ( milliseconds < 0 )
-        return;
+        return boost::ui::timeout_handle();
 
 #if wxUSE_TIMER
-    wxTimer* timer = new wxTimer(this);
-    m_timers.insert(std::make_pair( timer->GetId(), std::make_pair(timer, fn) ));
-    timer->StartOnce(milliseconds);
+    const boost::uint64_t expiry = boost::ui::detail::timeout_now() + milliseconds;
+    const boost::uint64_t id = m_wheel.schedule(expiry, fn);
+
+    if ( expiry < m_timer_expiry )
+        restart_timer();
+
+    return boost::ui::timeout_handle(id);
 #else
     fn();
+    return boost::ui::timeout_handle();
+#endif
+}
+
+bool boost_ui_app::cancel_timeout(boost::uint64_t id)
+{
+#if wxUSE_TIMER
+    // Native timer stays started, it just finds nothing to call
+    return m_wheel.cancel(id);
+#else
+    return false;
+#endif
+}
+
+bool boost_ui_app::timeout_pending(boost::uint64_t id) const
+{
+#if wxUSE_TIMER
+    return m_wheel.pending(id);
+#else
+    return false;
 #endif
 }
 
 #if wxUSE_TIMER
 void boost_ui_app::on_timer(wxTimerEvent& event)
 {
-    const int id_ = event.GetTimer().GetId();
-    timers_type::const_iterator iter = m_timers.find(id_);
-    wxCHECK_RET(iter != m_timers.end(), "Timer id not found");
-    iter->second.second();
+    wxCHECK_RET(&event.GetTimer() == m_timer, "Unknown timer");
+
+    // Timer stays started while timeout functions are called,
+    // so nested event loops of functions keep calling due timeouts
+    restart_timer();
+
+    restart_guard guard(*this);
+    m_wheel.advance(boost::ui::detail::timeout_now());
+}
+
+void boost_ui_app::restart_timer()
+{
+    if ( m_wheel.size() == 0 )
+    {
+        if ( m_timer )
+            m_timer->Stop();
+        m_timer_expiry = no_expiry;
+        return;
+    }
+
+    if ( !m_timer )
+        m_timer = new wxTimer(this);
+
+    // Next expiry can be a time of cascading timers between wheel levels
+    const boost::uint64_t now = boost::ui::detail::timeout_now();
+    const boost::uint64_t next = m_wheel.next_expiry();
+    const boost::uint64_t delay = next > now ? next - now : 1;
+
+    m_timer_expiry = next;
+    m_timer->StartOnce(static_cast<int>( (std::min)(delay, boost::uint64_t(INT_MAX)) ));
 }
 #endif
 
@@ -328,11 +461,62 @@ int entry(int (*ui_main)(int, char*[]), int argc, char* argv[])
     return detail::entry(argc, argv);
 }
 
+bool timeout_handle::cancel()
+{
+    if ( !m_id || !wxTheApp )
+        return false;
+
+    return wxGetApp().cancel_timeout(m_id);
+}
+
+bool timeout_handle::pending() const
+{
+    if ( !m_id || !wxTheApp )
+        return false;
+
+    return wxGetApp().timeout_pending(m_id);
+}
+
 namespace detail {
 
-void on_timeout(int milliseconds, const boost::function<void()>& fn)
+timeout_handle on_timeout(int milliseconds, const boost::function<void()>& fn)
+{
+    return wxGetApp().on_timeout(milliseconds, fn);
+}
+
+boost::uint64_t monotonic_now()
+{
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    return static_cast<boost::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#elif defined(__WINDOWS__)
+    LARGE_INTEGER frequency, counter;
+    ::QueryPerformanceFrequency(&frequency);
+    ::QueryPerformanceCounter(&counter);
+
+    // Split to avoid overflow of the counter multiplied by 10^6
+    const boost::uint64_t f = static_cast<boost::uint64_t>(frequency.QuadPart);
+    const boost::uint64_t c = static_cast<boost::uint64_t>(counter.QuadPart);
+    return c / f * 1000000 + c % f * 1000000 / f;
+#elif defined(__DARWIN__)
+    static mach_timebase_info_data_t timebase;
+    if ( timebase.denom == 0 )
+        ::mach_timebase_info(&timebase);
+
+    return ::mach_absolute_time() / 1000 * timebase.numer / timebase.denom;
+#else
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<boost::uint64_t>(ts.tv_sec) * 1000000 +
+           static_cast<boost::uint64_t>(ts.tv_nsec) / 1000;
+#endif
+}
+
+// Time base of the timer wheel
+boost::uint64_t timeout_now()
 {
-    wxGetApp().on_timeout(milliseconds, fn);
+    return monotonic_now() / 1000;
 }
 
 void sleep_for_milliseconds(unsigned long milliseconds)
@@ -0,0 +1,140 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/cancellation.hpp>
+#include <boost/ui/native/widget.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <map>
+
+#include <wx/window.h>
+
+namespace boost {
+namespace ui    {
+
+namespace {
+
+// Set when the window is destroyed, shared by all tokens of the window
+class window_state
+{
+public:
+    window_state() : m_destroyed(false) {}
+
+    void destroy()
+    {
+        m_destroyed.store(true, boost::memory_order_release);
+    }
+
+    bool destroyed() const
+    {
+        return m_destroyed.load(boost::memory_order_acquire);
+    }
+
+private:
+    boost::atomic<bool> m_destroyed;
+};
+
+// Accessed from the UI thread only.
+// Each window has one destroy handler however many tokens are bound to it
+typedef std::map< wxWindow*, boost::weak_ptr<window_state> > window_states_type;
+window_states_type g_window_states;
+
+// Destroy event of child window is propagated to its parents
+class destroy_functor
+{
+public:
+    destroy_functor(wxWindow* window, const boost::shared_ptr<window_state>& state)
+        : m_window(window), m_state(state) {}
+
+    void operator()(wxWindowDestroyEvent& event)
+    {
+        event.Skip();
+
+        if ( event.GetEventObject() == m_window )
+        {
+            m_state->destroy();
+            g_window_states.erase(m_window);
+        }
+    }
+
+private:
+    wxWindow* m_window;
+    boost::shared_ptr<window_state> m_state;
+};
+
+boost::shared_ptr<window_state> get_window_state(wxWindow* window)
+{
+    boost::weak_ptr<window_state>& weak = g_window_states[window];
+
+    boost::shared_ptr<window_state> state = weak.lock();
+    if ( !state )
+    {
+        state = boost::make_shared<window_state>();
+        weak = state;
+        window->Bind(wxEVT_DESTROY, destroy_functor(window, state));
+    }
+
+    return state;
+}
+
+} // unnamed namespace
+
+// Isn't checked by detail::memcheck because it is released from any thread
+class cancellation_token::impl
+{
+public:
+    impl() : m_cancelled(false) {}
+
+    explicit impl(const boost::shared_ptr<window_state>& window)
+        : m_cancelled(false), m_window(window) {}
+
+    void cancel()
+    {
+        m_cancelled.store(true, boost::memory_order_release);
+    }
+
+    bool cancelled() const
+    {
+        return m_cancelled.load(boost::memory_order_acquire) ||
+               (m_window && m_window->destroyed());
+    }
+
+private:
+    boost::atomic<bool> m_cancelled;
+    const boost::shared_ptr<window_state> m_window;
+};
+
+cancellation_token::cancellation_token()
+    : m_impl(boost::make_shared<impl>())
+{
+}
+
+cancellation_token::cancellation_token(widget& owner)
+{
+    wxWindow* window = native::from_widget(owner);
+    m_impl = window ? boost::make_shared<impl>(get_window_state(window))
+                    : boost::make_shared<impl>();
+    wxCHECK_RET(window, "Widget should be created");
+}
+
+void cancellation_token::cancel()
+{
+    m_impl->cancel();
+}
+
+bool cancellation_token::cancelled() const
+{
+    return m_impl->cancelled();
+}
+
+} // namespace ui
+} // namespace boost
@@ -16,10 +16,17 @@ namespace boost {
 namespace ui    {
 
 mouse_event::mouse_event() : m_x(-1), m_y(-1),
-    m_left(false), m_right(false), m_middle(false)
+    m_left(false), m_right(false), m_middle(false),
+    m_count(1), m_history(NULL)
 {
 }
 
+const std::vector<point>& mouse_event::history() const
+{
+    static const std::vector<point> empty;
+    return m_history ? *m_history : empty;
+}
+
 namespace native {
 
 template <>
@@ -0,0 +1,446 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/event_trace.hpp>
+#include <boost/ui/application.hpp>
+#include <boost/ui/native/event.hpp>
+#include <boost/ui/native/string.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <ostream>
+
+#include <wx/event.h>
+#include <wx/window.h>
+
+namespace boost {
+namespace ui    {
+
+namespace {
+
+// Values below 2^exact_bits are stored exactly,
+// each next power of two is split into 2^(exact_bits - 1) buckets
+const int exact_bits = 6;
+const unsigned exact_count = 1u << exact_bits;
+const unsigned sub_count = exact_count / 2;
+const boost::uint64_t max_histogram_value = 0xFFFFFFFFu;
+const std::size_t buckets_count = exact_count + (32 - exact_bits) * sub_count;
+
+int highest_bit(boost::uint64_t value)
+{
+    int bit = 0;
+    while ( value >>= 1 )
+        bit++;
+    return bit;
+}
+
+std::size_t bucket_index(boost::uint64_t value)
+{
+    if ( value < exact_count )
+        return static_cast<std::size_t>(value);
+
+    const int shift = highest_bit(value) - exact_bits + 1;
+    return exact_count + (shift - 1) * sub_count +
+           static_cast<std::size_t>((value >> shift) - sub_count);
+}
+
+// Returns the highest value that is stored in the bucket
+boost::uint64_t bucket_value(std::size_t index)
+{
+    if ( index < exact_count )
+        return index;
+
+    const int shift = static_cast<int>((index - exact_count) / sub_count) + 1;
+    const boost::uint64_t sub = (index - exact_count) % sub_count + sub_count;
+    return ((sub + 1) << shift) - 1;
+}
+
+} // unnamed namespace
+
+latency_histogram::latency_histogram()
+    : m_buckets(buckets_count), m_count(0), m_min(0), m_max(0), m_sum(0)
+{
+}
+
+void latency_histogram::record(boost::uint64_t microseconds)
+{
+    const boost::uint64_t value = (std::min)(microseconds, max_histogram_value);
+
+    m_buckets[bucket_index(value)]++;
+
+    if ( m_count == 0 || value < m_min )
+        m_min = value;
+    if ( value > m_max )
+        m_max = value;
+
+    m_count++;
+    m_sum += static_cast<double>(value);
+}
+
+void latency_histogram::clear()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+    m_sum = 0;
+}
+
+boost::uint64_t latency_histogram::min_value() const
+{
+    return m_min;
+}
+
+double latency_histogram::mean() const
+{
+    return m_count ? m_sum / static_cast<double>(m_count) : 0;
+}
+
+boost::uint64_t latency_histogram::value_at_percentile(double percentile) const
+{
+    if ( m_count == 0 )
+        return 0;
+
+    percentile = (std::max)(0.0, (std::min)(percentile, 100.0));
+    size_type target = static_cast<size_type>(
+        std::ceil(percentile / 100 * static_cast<double>(m_count)));
+    if ( target == 0 )
+        target = 1;
+
+    size_type total = 0;
+    for ( std::size_t i = 0; i < m_buckets.size(); i++ )
+    {
+        total += m_buckets[i];
+        if ( total >= target )
+            return (std::max)(m_min, (std::min)(bucket_value(i), m_max));
+    }
+
+    return m_max;
+}
+
+namespace {
+
+struct trace_handler
+{
+    wxString event_name;
+    wxString widget_name;
+    latency_histogram duration;
+    latency_histogram queue_latency;
+};
+
+struct trace_record
+{
+    boost::uint64_t begin;
+    boost::uint64_t duration;
+    boost::int64_t  queue_latency;
+    std::size_t     handler;
+};
+
+// Functor addresses are reused after unbinding or window destruction,
+// so handler, event object and event type are the part of the key
+struct trace_key
+{
+    const void* functor;
+    const void* handler;
+    const void* object;
+    wxEventType type;
+
+    bool operator<(const trace_key& other) const
+    {
+        if ( functor != other.functor )
+            return std::less<const void*>()(functor, other.functor);
+        if ( handler != other.handler )
+            return std::less<const void*>()(handler, other.handler);
+        if ( object != other.object )
+            return std::less<const void*>()(object, other.object);
+        return type < other.type;
+    }
+};
+
+typedef std::map<trace_key, std::size_t> handler_indices_type;
+
+// All data are accessed from the UI thread only
+std::vector<trace_handler> g_handlers;
+handler_indices_type g_handler_indices;
+std::vector<trace_record> g_records;
+std::size_t g_capacity = 0;
+std::size_t g_dropped = 0;
+unsigned g_generation = 0;
+boost::uint64_t g_start_time = 0;
+
+wxString event_type_name(wxEventType type)
+{
+    struct type_name
+    {
+        wxEventType type;
+        const char* name;
+    };
+
+    const type_name names[] =
+    {
+        { wxEVT_PAINT,          "paint" },
+        { wxEVT_SIZE,           "size" },
+        { wxEVT_MOVE,           "move" },
+        { wxEVT_IDLE,           "idle" },
+        { wxEVT_MOTION,         "mouse_move" },
+        { wxEVT_LEFT_DOWN,      "mouse_left_down" },
+        { wxEVT_LEFT_UP,        "mouse_left_up" },
+        { wxEVT_LEFT_DCLICK,    "mouse_left_double" },
+        { wxEVT_RIGHT_DOWN,     "mouse_right_down" },
+        { wxEVT_RIGHT_UP,       "mouse_right_up" },
+        { wxEVT_MIDDLE_DOWN,    "mouse_middle_down" },
+        { wxEVT_MIDDLE_UP,      "mouse_middle_up" },
+        { wxEVT_ENTER_WINDOW,   "mouse_enter" },
+        { wxEVT_LEAVE_WINDOW,   "mouse_leave" },
+        { wxEVT_MOUSEWHEEL,     "mouse_wheel" },
+        { wxEVT_KEY_DOWN,       "key_down" },
+        { wxEVT_KEY_UP,         "key_up" },
+        { wxEVT_CHAR,           "char" },
+        { wxEVT_SET_FOCUS,      "set_focus" },
+        { wxEVT_KILL_FOCUS,     "kill_focus" },
+        { wxEVT_BUTTON,         "press" },
+        { wxEVT_TEXT,           "edit" },
+        { wxEVT_MENU,           "menu" },
+        { wxEVT_CLOSE_WINDOW,   "close" },
+        { wxEVT_THREAD,         "thread" },
+    };
+
+    for ( std::size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++ )
+        if ( names[i].type == type )
+            return wxString::FromAscii(names[i].name);
+
+    return wxString::Format(wxS("event %d"), static_cast<int>(type));
+}
+
+wxString widget_name(wxEvtHandler* handler, const wxEvent& event)
+{
+    wxObject* object = event.GetEventObject();
+    if ( !object )
+        object = handler;
+    if ( !object )
+        return wxString();
+
+    wxString name;
+    const wxClassInfo* info = object->GetClassInfo();
+    if ( info )
+        name = info->GetClassName();
+
+    wxWindow* window = dynamic_cast<wxWindow*>(object);
+    if ( window )
+        name << wxS(' ') << window->GetName();
+
+    return name;
+}
+
+std::size_t add_handler(const trace_key& key, const wxString& event_name,
+                        const wxString& widget_name)
+{
+    g_handlers.push_back(trace_handler());
+    g_handlers.back().event_name  = event_name;
+    g_handlers.back().widget_name = widget_name;
+
+    const std::size_t index = g_handlers.size() - 1;
+    g_handler_indices.insert(std::make_pair(key, index));
+    return index;
+}
+
+// Native timestamps are milliseconds of the system uptime clock on most
+// platforms, latency is unknown if they look incomparable with it
+boost::int64_t native_queue_latency(const wxEvent& event, boost::uint64_t now)
+{
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    const long timestamp = event.GetTimestamp();
+    if ( timestamp == 0 )
+        return -1;
+
+    const boost::uint32_t latency = static_cast<boost::uint32_t>(now / 1000) -
+                                    static_cast<boost::uint32_t>(timestamp);
+    if ( latency < 10000 )
+        return static_cast<boost::int64_t>(latency) * 1000;
+#endif
+
+    return -1;
+}
+
+void write_json_string(std::ostream& os, const wxString& str)
+{
+    os << '"';
+
+    const wxScopedCharBuffer utf8 = str.utf8_str();
+    for ( const char* p = utf8.data(); *p; p++ )
+    {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if ( c == '"' || c == '\\' )
+            os << '\\' << *p;
+        else if ( c < 0x20 )
+        {
+            static const char hex[] = "0123456789abcdef";
+            os << "\\u00" << hex[c >> 4] << hex[c & 0xF];
+        }
+        else
+            os << *p;
+    }
+
+    os << '"';
+}
+
+} // unnamed namespace
+
+void event_trace::start(std::size_t capacity)
+{
+    g_capacity = capacity;
+    g_records.reserve((std::min)(capacity, std::size_t(65536)));
+
+    if ( g_start_time == 0 )
+        g_start_time = native::event_trace_now();
+
+    native::g_event_trace_running.store(true, boost::memory_order_relaxed);
+}
+
+void event_trace::stop()
+{
+    native::g_event_trace_running.store(false, boost::memory_order_relaxed);
+}
+
+bool event_trace::running()
+{
+    return native::event_trace_running();
+}
+
+void event_trace::clear()
+{
+    g_handlers.clear();
+    g_handler_indices.clear();
+    g_records.clear();
+    g_dropped = 0;
+    g_generation++;
+    g_start_time = running() ? native::event_trace_now() : 0;
+}
+
+std::vector<event_trace::handler_stats> event_trace::handlers()
+{
+    std::vector<handler_stats> result(g_handlers.size());
+
+    for ( std::size_t i = 0; i < g_handlers.size(); i++ )
+    {
+        wxString name = g_handlers[i].event_name;
+        if ( !g_handlers[i].widget_name.empty() )
+            name << wxS(' ') << g_handlers[i].widget_name;
+
+        result[i].name          = native::to_uistring(name);
+        result[i].duration      = g_handlers[i].duration;
+        result[i].queue_latency = g_handlers[i].queue_latency;
+    }
+
+    return result;
+}
+
+std::size_t event_trace::dropped_count()
+{
+    return g_dropped;
+}
+
+void event_trace::write_chrome_trace(std::ostream& os)
+{
+    os << "{\"traceEvents\":[";
+
+    for ( std::size_t i = 0; i < g_records.size(); i++ )
+    {
+        const trace_record& r = g_records[i];
+        const trace_handler& h = g_handlers[r.handler];
+
+        if ( i != 0 )
+            os << ',';
+        os << "\n{\"name\":";
+        write_json_string(os, h.event_name);
+        os << ",\"cat\":\"event\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+           << ",\"ts\":" << r.begin - g_start_time
+           << ",\"dur\":" << r.duration
+           << ",\"args\":{\"widget\":";
+        write_json_string(os, h.widget_name);
+        if ( r.queue_latency >= 0 )
+            os << ",\"queue_latency_us\":" << r.queue_latency;
+        os << "}}";
+    }
+
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+namespace native {
+
+boost::atomic<bool> g_event_trace_running(false);
+
+boost::uint64_t event_trace_now()
+{
+    return detail::monotonic_now();
+}
+
+event_trace_scope::event_trace_scope(const void* key, wxEvtHandler* handler,
+                                     const wxEvent& event)
+{
+    m_generation = g_generation;
+
+    // Names are built only for the first call of handler
+    const trace_key k = { key, handler, event.GetEventObject(), event.GetEventType() };
+    const handler_indices_type::iterator iter = g_handler_indices.find(k);
+    if ( iter != g_handler_indices.end() )
+        m_handler = iter->second;
+    else
+        m_handler = add_handler(k, event_type_name(event.GetEventType()),
+                                widget_name(handler, event));
+
+    m_begin = event_trace_now();
+    m_queue_latency = native_queue_latency(event, m_begin);
+}
+
+event_trace_scope::event_trace_scope(const void* key, const char* name,
+                                     boost::uint64_t enqueued)
+{
+    m_generation = g_generation;
+
+    const trace_key k = { key, NULL, NULL, wxEVT_NULL };
+    const handler_indices_type::iterator iter = g_handler_indices.find(k);
+    if ( iter != g_handler_indices.end() )
+        m_handler = iter->second;
+    else
+        m_handler = add_handler(k, wxString::FromAscii(name), wxString());
+
+    m_begin = event_trace_now();
+    m_queue_latency = m_begin >= enqueued ?
+        static_cast<boost::int64_t>(m_begin - enqueued) : 0;
+}
+
+event_trace_scope::~event_trace_scope()
+{
+    const boost::uint64_t duration = event_trace_now() - m_begin;
+
+    // Handler could clear trace
+    if ( m_generation != g_generation )
+        return;
+
+    trace_handler& h = g_handlers[m_handler];
+    h.duration.record(duration);
+    if ( m_queue_latency >= 0 )
+        h.queue_latency.record(static_cast<boost::uint64_t>(m_queue_latency));
+
+    if ( g_records.size() < g_capacity )
+    {
+        const trace_record r = { m_begin, duration, m_queue_latency, m_handler };
+        g_records.push_back(r);
+    }
+    else
+        g_dropped++;
+}
+
+} // namespace native
+
+} // namespace ui
+} // namespace boost
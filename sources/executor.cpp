@@ -0,0 +1,344 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/executor.hpp>
+#include <boost/ui/detail/memcheck.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+
+#include <deque>
+#include <vector>
+
+#include <wx/thread.h>
+
+#ifndef wxOVERRIDE
+#define wxOVERRIDE
+#endif
+
+namespace boost {
+namespace ui    {
+
+namespace detail {
+
+bool is_ui_thread()
+{
+    return wxThread::IsMain();
+}
+
+} // namespace detail
+
+// Workers pop own functions from the back and steal from the front
+// of other queues, pending count lets idle workers sleep
+// without locking all queues
+class thread_pool::impl : private detail::memcheck
+{
+public:
+    impl(std::size_t threads, std::size_t capacity)
+        : m_capacity(capacity), m_closed(false), m_pending(0), m_idle(0),
+          m_condition(m_mutex), m_not_full(m_mutex)
+    {
+        if ( threads == 0 )
+        {
+            const int cpus = wxThread::GetCPUCount();
+            threads = cpus > 0 ? static_cast<std::size_t>(cpus) : 1;
+        }
+
+        // Queues are created before threads start stealing from them
+        for ( std::size_t i = 0; i < threads; i++ )
+            m_queues.push_back(new local_queue);
+
+        for ( std::size_t i = 0; i < threads; i++ )
+        {
+            worker* w = new worker(*this, i);
+            if ( w->Run() != wxTHREAD_NO_ERROR )
+            {
+                delete w;
+                wxFAIL_MSG(wxS("Unable to start thread pool thread"));
+                break;
+            }
+            m_workers.push_back(w);
+        }
+    }
+
+    ~impl()
+    {
+        close();
+
+        for ( std::size_t i = 0; i < m_workers.size(); i++ )
+        {
+            m_workers[i]->Wait();
+            delete m_workers[i];
+        }
+        for ( std::size_t i = 0; i < m_queues.size(); i++ )
+            delete m_queues[i];
+    }
+
+    std::size_t size() const
+    {
+        return m_workers.size();
+    }
+
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    void post(const boost::function<void()>& fn)
+    {
+        if ( worker* w = current_worker() )
+        {
+            local_queue& queue = *m_queues[w->index()];
+            wxMutexLocker lock(queue.m_mutex);
+            queue.m_functions.push_back(fn);
+        }
+        else
+        {
+            wxMutexLocker lock(m_mutex);
+            while ( m_capacity && m_shared.size() >= m_capacity && !m_closed )
+                m_not_full.Wait();
+
+            wxCHECK_RET(!m_closed, "Thread pool is closed");
+            m_shared.push_back(fn);
+        }
+
+        // Idle worker checks pending count after it increments idle count
+        // under the mutex, so signal can't be lost
+        m_pending.fetch_add(1);
+        if ( m_idle.load() > 0 )
+        {
+            wxMutexLocker lock(m_mutex);
+            m_condition.Signal();
+        }
+    }
+
+    void close()
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+            m_closed = true;
+        }
+        m_condition.Broadcast();
+        m_not_full.Broadcast();
+    }
+
+    bool closed() const
+    {
+        wxMutexLocker lock(m_mutex);
+        return m_closed;
+    }
+
+    bool running_in_this_thread() const
+    {
+        return current_worker() != NULL;
+    }
+
+    bool try_executing_one()
+    {
+        worker* w = current_worker();
+
+        boost::function<void()> fn;
+        if ( !try_pop(w ? w->index() : m_queues.size(), fn) )
+            return false;
+
+        fn();
+        return true;
+    }
+
+private:
+    class worker : public wxThread
+    {
+    public:
+        worker(impl& pool, std::size_t index)
+            : wxThread(wxTHREAD_JOINABLE), m_pool(pool), m_index(index) {}
+
+        const impl& pool() const { return m_pool; }
+        std::size_t index() const { return m_index; }
+
+    protected:
+        virtual ExitCode Entry() wxOVERRIDE
+        {
+            boost::function<void()> fn;
+            while ( m_pool.wait_pop(m_index, fn) )
+            {
+                // Exception is rethrown in the UI thread like ui::task does,
+                // so the worker keeps running
+                try
+                {
+                    fn();
+                }
+                catch ( ... )
+                {
+                    detail::call_async(boost::bind(&rethrow,
+                                                   boost::current_exception()));
+                }
+                fn.clear();
+            }
+            return 0;
+        }
+
+    private:
+        static void rethrow(const boost::exception_ptr& e)
+        {
+            boost::rethrow_exception(e);
+        }
+
+        impl& m_pool;
+        const std::size_t m_index;
+    };
+
+    struct local_queue
+    {
+        wxMutex m_mutex;
+        std::deque< boost::function<void()> > m_functions;
+    };
+
+    // Returns worker of this pool that calls it or NULL
+    worker* current_worker() const
+    {
+        worker* w = dynamic_cast<worker*>(wxThread::This());
+        return w && &w->pool() == this ? w : NULL;
+    }
+
+    // Tries own queue, shared queue, then queues of other workers,
+    // index is equal to the count of queues for other threads
+    bool try_pop(std::size_t index, boost::function<void()>& fn)
+    {
+        const std::size_t count = m_queues.size();
+
+        if ( index < count && pop_back(*m_queues[index], fn) )
+            return true;
+
+        {
+            wxMutexLocker lock(m_mutex);
+            if ( !m_shared.empty() )
+            {
+                fn.swap(m_shared.front());
+                m_shared.pop_front();
+                m_pending.fetch_sub(1);
+                if ( m_capacity )
+                    m_not_full.Signal();
+                return true;
+            }
+        }
+
+        for ( std::size_t i = 1; i <= count; i++ )
+        {
+            const std::size_t victim = (index + i) % count;
+            if ( victim != index && pop_front(*m_queues[victim], fn) )
+                return true;
+        }
+
+        return false;
+    }
+
+    bool pop_back(local_queue& queue, boost::function<void()>& fn)
+    {
+        wxMutexLocker lock(queue.m_mutex);
+        if ( queue.m_functions.empty() )
+            return false;
+
+        fn.swap(queue.m_functions.back());
+        queue.m_functions.pop_back();
+        m_pending.fetch_sub(1);
+        return true;
+    }
+
+    bool pop_front(local_queue& queue, boost::function<void()>& fn)
+    {
+        wxMutexLocker lock(queue.m_mutex);
+        if ( queue.m_functions.empty() )
+            return false;
+
+        fn.swap(queue.m_functions.front());
+        queue.m_functions.pop_front();
+        m_pending.fetch_sub(1);
+        return true;
+    }
+
+    // Returns false when pool is closed and there are no more functions
+    bool wait_pop(std::size_t index, boost::function<void()>& fn)
+    {
+        while ( !try_pop(index, fn) )
+        {
+            wxMutexLocker lock(m_mutex);
+
+            m_idle.fetch_add(1);
+            while ( m_pending.load() == 0 && !m_closed )
+                m_condition.Wait();
+            m_idle.fetch_sub(1);
+
+            if ( m_pending.load() == 0 && m_closed )
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<worker*> m_workers;
+    std::vector<local_queue*> m_queues;
+
+    const std::size_t m_capacity;
+
+    mutable wxMutex m_mutex;
+    bool m_closed;
+    boost::atomic<std::size_t> m_pending;
+    boost::atomic<std::size_t> m_idle;
+    wxCondition m_condition;
+    wxCondition m_not_full;
+    std::deque< boost::function<void()> > m_shared;
+};
+
+thread_pool::thread_pool(std::size_t threads, std::size_t capacity)
+    : m_impl(new impl(threads, capacity))
+{
+}
+
+thread_pool::~thread_pool()
+{
+    delete m_impl;
+}
+
+std::size_t thread_pool::size() const
+{
+    return m_impl->size();
+}
+
+std::size_t thread_pool::capacity() const
+{
+    return m_impl->capacity();
+}
+
+void thread_pool::post_raw(const boost::function<void()>& fn)
+{
+    m_impl->post(fn);
+}
+
+bool thread_pool::running_in_this_thread() const
+{
+    return m_impl->running_in_this_thread();
+}
+
+void thread_pool::close()
+{
+    m_impl->close();
+}
+
+bool thread_pool::closed() const
+{
+    return m_impl->closed();
+}
+
+bool thread_pool::try_executing_one()
+{
+    return m_impl->try_executing_one();
+}
+
+} // namespace ui
+} // namespace boost
@@ -0,0 +1,304 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/fd_watcher.hpp>
+#include <boost/ui/detail/memcheck.hpp>
+
+#include <wx/app.h>
+#include <wx/apptrait.h>
+#include <wx/event.h>
+#include <wx/evtloop.h>
+
+#if wxUSE_EVENTLOOP_SOURCE
+#include <wx/evtloopsrc.h>
+#endif
+
+#ifndef wxOVERRIDE
+#define wxOVERRIDE
+#endif
+
+namespace boost {
+namespace ui    {
+
+#if wxUSE_EVENTLOOP_SOURCE
+
+namespace {
+
+enum fd_state
+{
+    fd_read,
+    fd_write,
+    fd_error
+};
+
+wxEventLoopSourcesManagerBase* sources_manager()
+{
+    wxAppTraits* traits = wxTheApp ? wxTheApp->GetTraits() : NULL;
+    return traits ? traits->GetEventLoopSourcesManager() : NULL;
+}
+
+wxDEFINE_EVENT(BOOST_UI_EVT_FD, wxCommandEvent);
+
+} // unnamed namespace
+
+// Native event loop calls source handler directly, so it processes its own event
+// that passes through boost_ui_app::CallEventHandler() for exceptions handling.
+// Source is registered again when the set of watched conditions changes.
+class fd_watcher::impl : public wxEvtHandler, public wxEventLoopSourceHandler,
+                         private detail::memcheck
+{
+public:
+    explicit impl(int fd)
+        : m_fd(fd), m_source(NULL), m_write_enabled(true),
+          m_dispatch_depth(0), m_closed(false)
+    {
+        Bind(BOOST_UI_EVT_FD, &impl::on_event, this);
+    }
+
+    ~impl()
+    {
+        delete m_source;
+    }
+
+    int fd() const { return m_fd; }
+
+    void set_handler(fd_state state, const boost::function<void()>& handler)
+    {
+        switch ( state )
+        {
+            case fd_read:  m_read  = handler; break;
+            case fd_write: m_write = handler; break;
+            case fd_error: m_error = handler; break;
+        }
+        update();
+    }
+
+    void enable_write(bool enable)
+    {
+        m_write_enabled = enable;
+        update();
+    }
+
+    // Deletes itself immediately or after handler that called it
+    void close()
+    {
+        delete m_source;
+        m_source = NULL;
+        m_closed = true;
+
+        if ( m_dispatch_depth == 0 )
+            delete this;
+    }
+
+    virtual void OnReadWaiting() wxOVERRIDE
+    {
+        dispatch(fd_read);
+    }
+
+    virtual void OnWriteWaiting() wxOVERRIDE
+    {
+        dispatch(fd_write);
+    }
+
+    virtual void OnExceptionWaiting() wxOVERRIDE
+    {
+        dispatch(fd_error);
+    }
+
+private:
+    void update()
+    {
+        int flags = 0;
+        if ( m_read )
+            flags |= wxEVENT_SOURCE_INPUT;
+        if ( m_write && m_write_enabled )
+            flags |= wxEVENT_SOURCE_OUTPUT;
+        if ( m_error )
+            flags |= wxEVENT_SOURCE_EXCEPTION;
+
+        delete m_source;
+        m_source = NULL;
+
+        if ( !flags )
+            return;
+
+        wxEventLoopSourcesManagerBase* manager = sources_manager();
+        wxCHECK_RET(manager, "File descriptors watching isn't supported");
+
+        m_source = manager->AddSourceForFD(m_fd, this, flags);
+        wxCHECK_RET(m_source, "Unable to watch file descriptor");
+    }
+
+    void dispatch(fd_state state)
+    {
+        if ( m_closed )
+            return;
+
+        wxCommandEvent event(BOOST_UI_EVT_FD);
+        event.SetInt(state);
+
+        // Handler can run nested event loop that dispatches events again
+        m_dispatch_depth++;
+        ProcessEvent(event);
+        m_dispatch_depth--;
+
+        if ( m_closed && m_dispatch_depth == 0 )
+            delete this;
+    }
+
+    void on_event(wxCommandEvent& event)
+    {
+        switch ( event.GetInt() )
+        {
+            case fd_read:
+                if ( m_read )
+                    m_read();
+                break;
+
+            case fd_write:
+                if ( m_write && m_write_enabled )
+                    m_write();
+                break;
+
+            case fd_error:
+                if ( m_error )
+                    m_error();
+                break;
+        }
+    }
+
+    const int m_fd;
+    wxEventLoopSource* m_source;
+
+    boost::function<void()> m_read;
+    boost::function<void()> m_write;
+    boost::function<void()> m_error;
+    bool m_write_enabled;
+
+    int m_dispatch_depth;
+    bool m_closed;
+};
+
+fd_watcher& fd_watcher::create(int fd)
+{
+    close();
+
+    wxCHECK_MSG(fd >= 0, *this, "Invalid file descriptor");
+    wxCHECK_MSG(is_supported(), *this, "File descriptors watching isn't supported");
+
+    m_impl = new impl(fd);
+    return *this;
+}
+
+fd_watcher::~fd_watcher()
+{
+    close();
+}
+
+void fd_watcher::on_read_raw(const boost::function<void()>& handler)
+{
+    wxCHECK_RET(m_impl, "Descriptor isn't watched");
+    m_impl->set_handler(fd_read, handler);
+}
+
+void fd_watcher::on_write_raw(const boost::function<void()>& handler)
+{
+    wxCHECK_RET(m_impl, "Descriptor isn't watched");
+    m_impl->set_handler(fd_write, handler);
+}
+
+void fd_watcher::on_error_raw(const boost::function<void()>& handler)
+{
+    wxCHECK_RET(m_impl, "Descriptor isn't watched");
+    m_impl->set_handler(fd_error, handler);
+}
+
+fd_watcher& fd_watcher::enable_write(bool enable)
+{
+    wxCHECK_MSG(m_impl, *this, "Descriptor isn't watched");
+    m_impl->enable_write(enable);
+    return *this;
+}
+
+void fd_watcher::close()
+{
+    if ( m_impl )
+    {
+        m_impl->close();
+        m_impl = NULL;
+    }
+}
+
+bool fd_watcher::is_open() const
+{
+    return m_impl != NULL;
+}
+
+int fd_watcher::fd() const
+{
+    return m_impl ? m_impl->fd() : -1;
+}
+
+bool fd_watcher::is_supported()
+{
+    return sources_manager() != NULL;
+}
+
+#else // !wxUSE_EVENTLOOP_SOURCE
+
+fd_watcher& fd_watcher::create(int)
+{
+    wxFAIL_MSG(wxS("File descriptors watching isn't supported"));
+    return *this;
+}
+
+fd_watcher::~fd_watcher()
+{
+}
+
+void fd_watcher::on_read_raw(const boost::function<void()>&)
+{
+}
+
+void fd_watcher::on_write_raw(const boost::function<void()>&)
+{
+}
+
+void fd_watcher::on_error_raw(const boost::function<void()>&)
+{
+}
+
+fd_watcher& fd_watcher::enable_write(bool)
+{
+    return *this;
+}
+
+void fd_watcher::close()
+{
+}
+
+bool fd_watcher::is_open() const
+{
+    return false;
+}
+
+int fd_watcher::fd() const
+{
+    return -1;
+}
+
+bool fd_watcher::is_supported()
+{
+    return false;
+}
+
+#endif // wxUSE_EVENTLOOP_SOURCE
+
+} // namespace ui
+} // namespace boost
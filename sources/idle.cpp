@@ -0,0 +1,131 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/idle.hpp>
+#include <boost/ui/native/event.hpp>
+
+#include <functional>
+#include <map>
+
+#include <wx/app.h>
+#include <wx/event.h>
+#include <wx/thread.h>
+#include <wx/utils.h>
+
+namespace boost {
+namespace ui    {
+
+namespace {
+
+typedef std::multimap< int, boost::function<void()>, std::greater<int> > tasks_type;
+
+// Accessed from the UI thread only.
+// Equal keys are kept in insertion order, so tasks of the same priority are FIFO
+tasks_type g_tasks;
+boost::uint64_t g_budget = 4000;
+bool g_bound = false;
+
+void on_idle_event(wxIdleEvent& event);
+
+// Handler is connected only while there are queued tasks,
+// so idle events aren't requested without work
+void bind_idle()
+{
+    wxTheApp->Bind(wxEVT_IDLE, &on_idle_event);
+    g_bound = true;
+}
+
+void unbind_idle()
+{
+    if ( !g_bound )
+        return;
+
+    if ( wxTheApp )
+        wxTheApp->Unbind(wxEVT_IDLE, &on_idle_event);
+    g_bound = false;
+}
+
+// Requests more idle events or disconnects handler even if task throws exception
+class idle_guard
+{
+public:
+    explicit idle_guard(wxIdleEvent& event) : m_event(event) {}
+
+    ~idle_guard()
+    {
+        if ( g_tasks.empty() )
+            unbind_idle();
+        else
+            m_event.RequestMore();
+    }
+
+private:
+    wxIdleEvent& m_event;
+};
+
+void on_idle_event(wxIdleEvent& event)
+{
+    event.Skip();
+
+    if ( g_tasks.empty() )
+        return;
+
+    idle_guard guard(event);
+
+    const boost::uint64_t start = native::event_trace_now();
+    do
+    {
+        boost::function<void()> task;
+        task.swap(g_tasks.begin()->second);
+        g_tasks.erase(g_tasks.begin());
+
+        task();
+    }
+    while ( !g_tasks.empty() && native::event_trace_now() - start < g_budget );
+}
+
+} // unnamed namespace
+
+namespace detail {
+
+void idle_budget(boost::uint64_t microseconds)
+{
+    g_budget = microseconds;
+}
+
+void clear_idle_tasks()
+{
+    unbind_idle();
+    g_tasks.clear();
+}
+
+} // namespace detail
+
+void on_idle(const boost::function<void()>& task, int priority)
+{
+    wxCHECK_RET(task, "Invalid idle task");
+    wxCHECK_RET(wxTheApp, "Application should be running");
+    wxCHECK_RET(wxThread::IsMain(), "on_idle() should be called from the UI thread");
+
+    g_tasks.insert(tasks_type::value_type(priority, task));
+
+    if ( !g_bound )
+    {
+        bind_idle();
+        wxWakeUpIdle();
+    }
+}
+
+std::size_t idle_tasks_count()
+{
+    return g_tasks.size();
+}
+
+} // namespace ui
+} // namespace boost
@@ -0,0 +1,538 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/input_recorder.hpp>
+#include <boost/ui/native/event.hpp>
+#include <boost/ui/detail/memcheck.hpp>
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <wx/app.h>
+#include <wx/eventfilter.h>
+#include <wx/toplevel.h>
+#include <wx/utils.h>
+
+#ifndef wxOVERRIDE
+#define wxOVERRIDE
+#endif
+
+namespace boost {
+namespace ui    {
+
+namespace {
+
+// Native event fields that are enough to reproduce mouse and key events
+struct input_event
+{
+    boost::uint64_t time;
+    std::string type;
+    std::string path;
+    int x;
+    int y;
+    int modifiers;
+    int buttons;
+    int wheel_rotation;
+    int wheel_delta;
+    int wheel_axis;
+    int key_code;
+    long unicode_key;
+};
+
+enum
+{
+    button_left   = 1,
+    button_middle = 2,
+    button_right  = 4
+};
+
+struct event_type_name
+{
+    wxEventType type;
+    const char* name;
+    bool mouse;
+};
+
+const event_type_name* event_type_names(std::size_t& count)
+{
+    static const event_type_name names[] =
+    {
+        { wxEVT_MOTION,         "mouse_move",           true  },
+        { wxEVT_LEFT_DOWN,      "mouse_left_down",      true  },
+        { wxEVT_LEFT_UP,        "mouse_left_up",        true  },
+        { wxEVT_LEFT_DCLICK,    "mouse_left_double",    true  },
+        { wxEVT_RIGHT_DOWN,     "mouse_right_down",     true  },
+        { wxEVT_RIGHT_UP,       "mouse_right_up",       true  },
+        { wxEVT_RIGHT_DCLICK,   "mouse_right_double",   true  },
+        { wxEVT_MIDDLE_DOWN,    "mouse_middle_down",    true  },
+        { wxEVT_MIDDLE_UP,      "mouse_middle_up",      true  },
+        { wxEVT_MIDDLE_DCLICK,  "mouse_middle_double",  true  },
+        { wxEVT_MOUSEWHEEL,     "mouse_wheel",          true  },
+        { wxEVT_KEY_DOWN,       "key_down",             false },
+        { wxEVT_KEY_UP,         "key_up",               false },
+        { wxEVT_CHAR,           "char",                 false },
+    };
+
+    count = sizeof(names) / sizeof(names[0]);
+    return names;
+}
+
+const event_type_name* find_type(wxEventType type)
+{
+    std::size_t count;
+    const event_type_name* names = event_type_names(count);
+    for ( std::size_t i = 0; i < count; i++ )
+        if ( names[i].type == type )
+            return &names[i];
+    return NULL;
+}
+
+const event_type_name* find_type(const std::string& name)
+{
+    std::size_t count;
+    const event_type_name* names = event_type_names(count);
+    for ( std::size_t i = 0; i < count; i++ )
+        if ( name == names[i].name )
+            return &names[i];
+    return NULL;
+}
+
+// Returns indices of windows starting from the top level window,
+// for example "0/2/1"
+std::string window_path(wxWindow* window)
+{
+    std::vector<std::size_t> indices;
+
+    for ( ; window && !window->IsTopLevel(); window = window->GetParent() )
+    {
+        // Popups can be created without parent and aren't top level windows
+        wxWindow* parent = window->GetParent();
+        if ( !parent )
+            return std::string();
+
+        const int index = parent->GetChildren().IndexOf(window);
+        if ( index == wxNOT_FOUND )
+            return std::string();
+
+        indices.push_back(static_cast<std::size_t>(index));
+    }
+
+    if ( !window )
+        return std::string();
+
+    // Window can be removed from the list during its destruction
+    const int index = wxTopLevelWindows.IndexOf(window);
+    if ( index == wxNOT_FOUND )
+        return std::string();
+
+    indices.push_back(static_cast<std::size_t>(index));
+
+    std::ostringstream ss;
+    for ( std::vector<std::size_t>::reverse_iterator iter = indices.rbegin();
+          iter != indices.rend(); ++iter )
+    {
+        if ( iter != indices.rbegin() )
+            ss << '/';
+        ss << *iter;
+    }
+
+    return ss.str();
+}
+
+wxWindow* find_window(const std::string& path)
+{
+    std::istringstream ss(path);
+
+    std::size_t index;
+    if ( !(ss >> index) || index >= wxTopLevelWindows.size() )
+        return NULL;
+
+    wxWindow* window = wxTopLevelWindows.Item(index)->GetData();
+
+    char separator;
+    while ( ss >> separator >> index )
+    {
+        const wxWindowList& children = window->GetChildren();
+        if ( separator != '/' || index >= children.size() )
+            return NULL;
+        window = children.Item(index)->GetData();
+    }
+
+    return window;
+}
+
+void write_event(std::ostream& os, const input_event& e)
+{
+    os  << e.time << ' ' << e.type << ' ' << e.path << ' '
+        << e.x << ' ' << e.y << ' ' << e.modifiers << ' ' << e.buttons << ' '
+        << e.wheel_rotation << ' ' << e.wheel_delta << ' ' << e.wheel_axis << ' '
+        << e.key_code << ' ' << e.unicode_key << '\n';
+}
+
+bool read_event(const std::string& line, input_event& e)
+{
+    std::istringstream ss(line);
+    return ss >> e.time >> e.type >> e.path
+              >> e.x >> e.y >> e.modifiers >> e.buttons
+              >> e.wheel_rotation >> e.wheel_delta >> e.wheel_axis
+              >> e.key_code >> e.unicode_key
+           && find_type(e.type);
+}
+
+void set_modifiers(wxKeyboardState& state, int modifiers)
+{
+    state.SetControlDown((modifiers & wxMOD_CONTROL) != 0);
+    state.SetShiftDown  ((modifiers & wxMOD_SHIFT)   != 0);
+    state.SetAltDown    ((modifiers & wxMOD_ALT)     != 0);
+    state.SetMetaDown   ((modifiers & wxMOD_META)    != 0);
+}
+
+wxEvent* create_event(const input_event& e, wxWindow* window)
+{
+    const event_type_name* type = find_type(e.type);
+    wxCHECK_MSG(type, NULL, "Unknown event type");
+
+    wxEvent* result;
+
+    if ( type->mouse )
+    {
+        wxMouseEvent* event = new wxMouseEvent(type->type);
+        event->m_x = e.x;
+        event->m_y = e.y;
+        event->m_leftDown   = (e.buttons & button_left)   != 0;
+        event->m_middleDown = (e.buttons & button_middle) != 0;
+        event->m_rightDown  = (e.buttons & button_right)  != 0;
+        event->m_wheelRotation = e.wheel_rotation;
+        event->m_wheelDelta    = e.wheel_delta;
+        event->m_wheelAxis     = static_cast<wxMouseWheelAxis>(e.wheel_axis);
+        set_modifiers(*event, e.modifiers);
+        result = event;
+    }
+    else
+    {
+        wxKeyEvent* event = new wxKeyEvent(type->type);
+        event->m_x = e.x;
+        event->m_y = e.y;
+        event->m_keyCode = e.key_code;
+#if wxUSE_UNICODE
+        event->m_uniChar = static_cast<wxChar>(e.unicode_key);
+#endif
+        set_modifiers(*event, e.modifiers);
+        result = event;
+    }
+
+    result->SetEventObject(window);
+    result->SetId(window->GetId());
+    return result;
+}
+
+} // unnamed namespace
+
+//------------------------------------------------------------------------------
+
+class input_recorder::impl : public wxEventFilter, private detail::memcheck
+{
+public:
+    impl() : m_running(false), m_start(0) {}
+
+    ~impl()
+    {
+        stop();
+    }
+
+    void start()
+    {
+        if ( m_running )
+            return;
+
+        if ( m_events.empty() )
+            m_start = native::event_trace_now();
+
+        wxEvtHandler::AddFilter(this);
+        m_running = true;
+    }
+
+    void stop()
+    {
+        if ( !m_running )
+            return;
+
+        wxEvtHandler::RemoveFilter(this);
+        m_running = false;
+    }
+
+    bool running() const { return m_running; }
+
+    void clear()
+    {
+        m_events.clear();
+        m_start = native::event_trace_now();
+    }
+
+    std::size_t size() const { return m_events.size(); }
+
+    void save(std::ostream& os) const
+    {
+        for ( std::size_t i = 0; i < m_events.size(); i++ )
+            write_event(os, m_events[i]);
+    }
+
+    virtual int FilterEvent(wxEvent& event) wxOVERRIDE
+    {
+        const event_type_name* type = find_type(event.GetEventType());
+        if ( type )
+            record(*type, event);
+
+        return Event_Skip;
+    }
+
+private:
+    void record(const event_type_name& type, wxEvent& event)
+    {
+        wxWindow* window = wxDynamicCast(event.GetEventObject(), wxWindow);
+        if ( !window )
+            return;
+
+        input_event e;
+        e.time = native::event_trace_now() - m_start;
+        e.type = type.name;
+        e.path = window_path(window);
+        e.modifiers = e.buttons = e.wheel_rotation = e.wheel_delta =
+            e.wheel_axis = e.key_code = 0;
+        e.unicode_key = 0;
+
+        if ( e.path.empty() )
+            return;
+
+        if ( type.mouse )
+        {
+            const wxMouseEvent& m = static_cast<const wxMouseEvent&>(event);
+            e.x = m.GetX();
+            e.y = m.GetY();
+            e.modifiers = m.GetModifiers();
+            e.buttons = (m.LeftIsDown()   ? button_left   : 0) |
+                        (m.MiddleIsDown() ? button_middle : 0) |
+                        (m.RightIsDown()  ? button_right  : 0);
+            e.wheel_rotation = m.GetWheelRotation();
+            e.wheel_delta    = m.GetWheelDelta();
+            e.wheel_axis     = static_cast<int>(m.GetWheelAxis());
+        }
+        else
+        {
+            const wxKeyEvent& k = static_cast<const wxKeyEvent&>(event);
+            e.x = k.GetX();
+            e.y = k.GetY();
+            e.modifiers = k.GetModifiers();
+            e.key_code = k.GetKeyCode();
+#if wxUSE_UNICODE
+            e.unicode_key = static_cast<long>(k.GetUnicodeKey());
+#endif
+        }
+
+        m_events.push_back(e);
+    }
+
+    bool m_running;
+    boost::uint64_t m_start;
+    std::vector<input_event> m_events;
+};
+
+input_recorder::input_recorder() : m_impl(new impl)
+{
+}
+
+input_recorder::~input_recorder()
+{
+    delete m_impl;
+}
+
+void input_recorder::start()
+{
+    m_impl->start();
+}
+
+void input_recorder::stop()
+{
+    m_impl->stop();
+}
+
+bool input_recorder::running() const
+{
+    return m_impl->running();
+}
+
+void input_recorder::clear()
+{
+    m_impl->clear();
+}
+
+std::size_t input_recorder::size() const
+{
+    return m_impl->size();
+}
+
+void input_recorder::save(std::ostream& os) const
+{
+    m_impl->save(os);
+}
+
+//------------------------------------------------------------------------------
+
+class input_replayer::impl : private detail::memcheck
+{
+public:
+    impl() : m_speed(1), m_missing(0) {}
+
+    bool load(std::istream& is)
+    {
+        m_events.clear();
+
+        std::string line;
+        while ( std::getline(is, line) )
+        {
+            if ( line.empty() )
+                continue;
+
+            input_event e;
+            if ( !read_event(line, e) )
+            {
+                m_events.clear();
+                return false;
+            }
+
+            m_events.push_back(e);
+        }
+
+        return true;
+    }
+
+    void speed(double factor)
+    {
+        wxCHECK_RET(factor >= 0, "Speed should be non-negative");
+        m_speed = factor;
+    }
+
+    double speed() const { return m_speed; }
+
+    void replay()
+    {
+        wxCHECK_RET(wxTheApp, "Application should be running");
+
+        m_latency.clear();
+        m_missing = 0;
+
+        const boost::uint64_t start = native::event_trace_now();
+
+        for ( std::size_t i = 0; i < m_events.size(); i++ )
+        {
+            const input_event& e = m_events[i];
+
+            boost::uint64_t scheduled = native::event_trace_now();
+            if ( m_speed > 0 )
+            {
+                scheduled = start + static_cast<boost::uint64_t>(e.time / m_speed);
+                wait_until(scheduled);
+            }
+
+            // Previous events could destroy or create widgets
+            wxWindow* window = find_window(e.path);
+            if ( !window )
+            {
+                m_missing++;
+                continue;
+            }
+
+            wxEvent* event = create_event(e, window);
+            if ( !event )
+                continue;
+
+            window->GetEventHandler()->QueueEvent(event);
+            wxTheApp->ProcessPendingEvents();
+
+            m_latency.record(native::event_trace_now() - scheduled);
+        }
+    }
+
+    std::size_t size() const { return m_events.size(); }
+    std::size_t missing_count() const { return m_missing; }
+    const latency_histogram& latency() const { return m_latency; }
+
+private:
+    // Processes other events while waiting
+    static void wait_until(boost::uint64_t time)
+    {
+        for ( ;; )
+        {
+            wxTheApp->Yield(true);
+
+            const boost::uint64_t now = native::event_trace_now();
+            if ( now >= time )
+                break;
+
+            if ( time - now > 1000 )
+                wxMilliSleep(1);
+        }
+    }
+
+    double m_speed;
+    std::size_t m_missing;
+    std::vector<input_event> m_events;
+    latency_histogram m_latency;
+};
+
+input_replayer::input_replayer() : m_impl(new impl)
+{
+}
+
+input_replayer::~input_replayer()
+{
+    delete m_impl;
+}
+
+bool input_replayer::load(std::istream& is)
+{
+    return m_impl->load(is);
+}
+
+input_replayer& input_replayer::speed(double factor)
+{
+    m_impl->speed(factor);
+    return *this;
+}
+
+double input_replayer::speed() const
+{
+    return m_impl->speed();
+}
+
+void input_replayer::replay()
+{
+    m_impl->replay();
+}
+
+std::size_t input_replayer::size() const
+{
+    return m_impl->size();
+}
+
+std::size_t input_replayer::missing_count() const
+{
+    return m_impl->missing_count();
+}
+
+const latency_histogram& input_replayer::latency() const
+{
+    return m_impl->latency();
+}
+
+} // namespace ui
+} // namespace boost
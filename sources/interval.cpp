@@ -0,0 +1,436 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/interval.hpp>
+#include <boost/ui/application.hpp>
+#include <boost/ui/thread.hpp>
+#include <boost/ui/native/event.hpp>
+#include <boost/ui/detail/memcheck.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <set>
+#include <vector>
+
+#include <wx/thread.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+#ifndef wxOVERRIDE
+#define wxOVERRIDE
+#endif
+
+namespace boost  {
+namespace ui     {
+namespace detail {
+
+namespace {
+
+// Running intervals, accessed from the UI thread only
+std::set< boost::shared_ptr<interval_impl> > g_intervals;
+
+} // unnamed namespace
+
+// Periods that are whole milliseconds are scheduled by on_timeout(),
+// other ones are ticked by timer thread that queues itself into call_async()
+class interval_impl : public boost::enable_shared_from_this<interval_impl>,
+                      private async_item, private memcheck
+{
+public:
+    interval_impl(boost::uint64_t period, const boost::function<void()>& fn);
+    ~interval_impl();
+
+    void start();
+    bool cancel();
+    bool running() const { return m_running; }
+    interval_stats stats() const;
+
+private:
+    class timer_thread;
+
+    // Millisecond mode
+    void schedule();
+    void on_timer();
+
+    // High resolution mode, called from the timer thread
+    void post_tick(boost::uint64_t deadline, boost::uint64_t skipped);
+    static void on_tick(async_item* item);
+
+    void invoke(boost::uint64_t deadline);
+
+    const boost::uint64_t m_period;
+    const boost::function<void()> m_fn;
+    bool m_running;
+
+    boost::uint64_t m_deadline;
+    timeout_handle m_timeout;
+
+    timer_thread* m_thread;
+    boost::atomic<bool> m_queued;
+    boost::uint64_t m_queued_deadline;
+
+    // Keeps queued tick valid after cancel()
+    boost::shared_ptr<interval_impl> m_self;
+
+    boost::uint64_t m_ticks;
+    boost::atomic<boost::uint64_t> m_missed;
+    latency_histogram m_lateness;
+};
+
+class interval_impl::timer_thread : public wxThread
+{
+public:
+    explicit timer_thread(interval_impl& owner)
+        : wxThread(wxTHREAD_JOINABLE), m_owner(owner),
+          m_condition(m_mutex), m_stop(false)
+    {
+#ifdef __linux__
+        m_timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        m_stop_fd  = ::eventfd(0, EFD_CLOEXEC);
+#endif
+    }
+
+    ~timer_thread()
+    {
+#ifdef __linux__
+        if ( m_timer_fd >= 0 )
+            ::close(m_timer_fd);
+        if ( m_stop_fd >= 0 )
+            ::close(m_stop_fd);
+#endif
+    }
+
+    void stop()
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.Signal();
+
+#ifdef __linux__
+        if ( m_stop_fd >= 0 )
+        {
+            const boost::uint64_t value = 1;
+            const ssize_t written = ::write(m_stop_fd, &value, sizeof(value));
+            (void)written;
+        }
+#endif
+
+        Wait();
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+#ifdef __linux__
+        if ( m_timer_fd >= 0 && m_stop_fd >= 0 )
+            run_timerfd();
+        else
+#endif
+            run_sleep();
+
+        return 0;
+    }
+
+private:
+#ifdef __linux__
+    // Kernel keeps periodic timer on absolute deadlines
+    // and reports count of expirations since the last read
+    void run_timerfd()
+    {
+        const boost::uint64_t period = m_owner.m_period;
+
+        itimerspec spec;
+        spec.it_interval.tv_sec  = static_cast<time_t>(period / 1000000);
+        spec.it_interval.tv_nsec = static_cast<long>(period % 1000000 * 1000);
+        spec.it_value = spec.it_interval;
+
+        boost::uint64_t deadline = native::event_trace_now() + period;
+        if ( ::timerfd_settime(m_timer_fd, 0, &spec, NULL) != 0 )
+        {
+            run_sleep();
+            return;
+        }
+
+        pollfd fds[2];
+        fds[0].fd = m_timer_fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = m_stop_fd;
+        fds[1].events = POLLIN;
+
+        while ( true )
+        {
+            fds[0].revents = fds[1].revents = 0;
+            if ( ::poll(fds, 2, -1) < 0 )
+                continue; // EINTR
+
+            if ( fds[1].revents )
+                break;
+
+            boost::uint64_t expirations = 0;
+            if ( ::read(m_timer_fd, &expirations, sizeof(expirations))
+                    != sizeof(expirations) || expirations == 0 )
+                continue;
+
+            deadline += (expirations - 1) * period;
+            m_owner.post_tick(deadline, expirations - 1);
+            deadline += period;
+        }
+    }
+#endif
+
+    // Portable fallback, sleeps less than 1 ms precisely
+    void run_sleep()
+    {
+        const boost::uint64_t period = m_owner.m_period;
+        boost::uint64_t deadline = native::event_trace_now() + period;
+
+        while ( wait_until(deadline) )
+        {
+            const boost::uint64_t now = native::event_trace_now();
+            const boost::uint64_t skipped = (now - deadline) / period;
+
+            deadline += skipped * period;
+            m_owner.post_tick(deadline, skipped);
+            deadline += period;
+        }
+    }
+
+    // Returns false if thread should stop
+    bool wait_until(boost::uint64_t deadline)
+    {
+        wxMutexLocker lock(m_mutex);
+        while ( !m_stop )
+        {
+            const boost::uint64_t now = native::event_trace_now();
+            if ( now >= deadline )
+                return true;
+
+            const boost::uint64_t remaining = deadline - now;
+            if ( remaining >= 2000 )
+            {
+                m_condition.WaitTimeout(static_cast<unsigned long>(
+                    (std::min)((remaining - 1000) / 1000, boost::uint64_t(INT_MAX))));
+            }
+            else
+            {
+                m_mutex.Unlock();
+                wxMicroSleep(static_cast<unsigned long>(remaining));
+                m_mutex.Lock();
+            }
+        }
+        return false;
+    }
+
+    interval_impl& m_owner;
+
+    wxMutex m_mutex;
+    wxCondition m_condition;
+    bool m_stop;
+
+#ifdef __linux__
+    int m_timer_fd;
+    int m_stop_fd;
+#endif
+};
+
+interval_impl::interval_impl(boost::uint64_t period, const boost::function<void()>& fn)
+    : m_period(period), m_fn(fn), m_running(false), m_deadline(0),
+      m_thread(NULL), m_queued(false), m_queued_deadline(0),
+      m_ticks(0), m_missed(0)
+{
+    call = &interval_impl::on_tick;
+    next = NULL;
+}
+
+interval_impl::~interval_impl()
+{
+    if ( m_thread )
+    {
+        m_thread->stop();
+        delete m_thread;
+    }
+}
+
+void interval_impl::start()
+{
+    m_running = true;
+
+    if ( m_period % 1000 != 0 )
+    {
+        m_thread = new timer_thread(*this);
+        if ( m_thread->Run() == wxTHREAD_NO_ERROR )
+            return;
+
+        delete m_thread;
+        m_thread = NULL;
+        wxFAIL_MSG(wxS("Unable to start interval timer thread"));
+    }
+
+    m_deadline = native::event_trace_now() + m_period;
+    schedule();
+}
+
+bool interval_impl::cancel()
+{
+    if ( !m_running )
+        return false;
+
+    m_running = false;
+    m_timeout.cancel();
+
+    if ( m_thread )
+    {
+        m_thread->stop();
+        delete m_thread;
+        m_thread = NULL;
+    }
+
+    if ( m_queued.load(boost::memory_order_acquire) )
+        m_self = shared_from_this();
+
+    g_intervals.erase(shared_from_this());
+    return true;
+}
+
+interval_stats interval_impl::stats() const
+{
+    interval_stats result;
+    result.ticks = m_ticks;
+    result.missed = m_missed.load(boost::memory_order_relaxed);
+    result.lateness = m_lateness;
+    return result;
+}
+
+void interval_impl::schedule()
+{
+    // Rounds up, so function isn't called before its deadline
+    const boost::uint64_t now = native::event_trace_now();
+    const boost::uint64_t delay = m_deadline > now ? (m_deadline - now + 999) / 1000 : 0;
+
+    m_timeout = on_timeout(static_cast<int>( (std::min)(delay, boost::uint64_t(INT_MAX)) ),
+                           boost::bind(&interval_impl::on_timer, this));
+}
+
+void interval_impl::on_timer()
+{
+    const boost::shared_ptr<interval_impl> self = shared_from_this();
+
+    const boost::uint64_t now = native::event_trace_now();
+    const boost::uint64_t skipped = now > m_deadline ? (now - m_deadline) / m_period : 0;
+    const boost::uint64_t deadline = m_deadline + skipped * m_period;
+
+    m_missed.fetch_add(skipped, boost::memory_order_relaxed);
+    m_deadline = deadline + m_period;
+
+    // Before call, so exception doesn't stop the timer
+    schedule();
+
+    invoke(deadline);
+}
+
+void interval_impl::post_tick(boost::uint64_t deadline, boost::uint64_t skipped)
+{
+    // Previous tick is still waiting in the queue
+    if ( m_queued.load(boost::memory_order_acquire) )
+        skipped++;
+    else
+    {
+        m_queued_deadline = deadline;
+        m_queued.store(true, boost::memory_order_relaxed);
+        call_async(static_cast<async_item*>(this));
+    }
+
+    if ( skipped )
+        m_missed.fetch_add(skipped, boost::memory_order_relaxed);
+}
+
+void interval_impl::on_tick(async_item* item)
+{
+    interval_impl* impl = static_cast<interval_impl*>(item);
+
+    boost::shared_ptr<interval_impl> self;
+    self.swap(impl->m_self);
+    if ( !self )
+        self = impl->shared_from_this();
+
+    const boost::uint64_t deadline = impl->m_queued_deadline;
+    impl->m_queued.store(false, boost::memory_order_release);
+
+    if ( impl->m_running )
+        impl->invoke(deadline);
+}
+
+void interval_impl::invoke(boost::uint64_t deadline)
+{
+    const boost::uint64_t now = native::event_trace_now();
+    m_lateness.record(now > deadline ? now - deadline : 0);
+    m_ticks++;
+
+    m_fn();
+}
+
+interval_handle on_interval(boost::uint64_t microseconds,
+                            const boost::function<void()>& fn)
+{
+    wxCHECK_MSG(microseconds > 0, interval_handle(), "Interval period should be positive");
+
+    const boost::shared_ptr<interval_impl> impl =
+        boost::make_shared<interval_impl>(microseconds, fn);
+    g_intervals.insert(impl);
+    impl->start();
+
+    return interval_handle(impl);
+}
+
+void cancel_intervals()
+{
+    const std::vector< boost::shared_ptr<interval_impl> >
+        intervals(g_intervals.begin(), g_intervals.end());
+
+    for ( std::size_t i = 0; i < intervals.size(); i++ )
+        intervals[i]->cancel();
+}
+
+} // namespace detail
+
+bool interval_handle::cancel()
+{
+    return m_impl && m_impl->cancel();
+}
+
+bool interval_handle::running() const
+{
+    return m_impl && m_impl->running();
+}
+
+interval_stats interval_handle::stats() const
+{
+    if ( m_impl )
+        return m_impl->stats();
+
+    interval_stats result;
+    result.ticks = 0;
+    result.missed = 0;
+    return result;
+}
+
+} // namespace ui
+} // namespace boost
@@ -8,32 +8,373 @@
 #include <boost/ui/native/config.hpp>
 
 #include <boost/ui/log.hpp>
+#include <boost/ui/application.hpp>
+#include <boost/ui/native/event.hpp>
 #include <boost/ui/native/string.hpp>
+#include <boost/ui/detail/to_chars.hpp>
+#include <boost/ui/detail/log_binary.hpp>
+#include <boost/ui/detail/log_sink.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <cwchar>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <wx/log.h>
+#include <wx/thread.h>
+#include <wx/tls.h>
+#include <wx/ffile.h>
+#include <wx/datetime.h>
+#include <wx/time.h>
+
+#ifndef wxOVERRIDE
+#define wxOVERRIDE
+#endif
 
 namespace boost {
 namespace ui    {
 
+namespace detail {
+
+log_streambuf::int_type log_streambuf::overflow(int_type ch)
+{
+    m_overflow.append(pbase(), pptr());
+    setp(m_buffer, m_buffer + sizeof m_buffer);
+
+    if ( !traits_type::eq_int_type(ch, traits_type::eof()) )
+        m_overflow.push_back(traits_type::to_char_type(ch));
+
+    return traits_type::not_eof(ch);
+}
+
+void log_streambuf::append_to(uistring& str)
+{
+    if ( !m_overflow.empty() )
+    {
+        // Long output, allocations don't matter here
+        m_overflow.append(pbase(), pptr());
+        str.append(uistring(m_overflow));
+        return;
+    }
+
+    const char* begin = pbase();
+    const char* end   = pptr();
+    for ( const char* p = begin; p != end; ++p )
+    {
+        if ( static_cast<unsigned char>(*p) >= 0x80 )
+        {
+            str.append(uistring(std::string(begin, end)));
+            return;
+        }
+    }
+
+    str.append_ascii(begin, end - begin);
+}
+
+void log_streambuf::append_to(log_binary_buffer& buf)
+{
+    const std::size_t length = m_overflow.size() + (pptr() - pbase());
+    buf.value(static_cast<boost::uint32_t>(length));
+    buf.bytes(m_overflow.data(), m_overflow.size());
+    buf.bytes(pbase(), pptr() - pbase());
+}
+
+// Formatted location and filtering state of a call site
+class log_site : private boost::noncopyable
+{
+public:
+    log_site(boost::uint32_t id, const char* file, int line, const char* fn)
+        : m_id(id), m_has_file(file != NULL), m_line(line), m_has_fn(fn != NULL), m_generation(0),
+          m_arrival(0), m_rate_limited(0), m_last_hash(0), m_last_level(-1), m_repeats(0)
+    {
+        if ( file )
+        {
+            m_file = file;
+            m_text.append_ascii(file, m_file.size());
+        }
+        if ( line >= 0 )
+        {
+            m_text.push_back(L'[');
+            detail::append_integer(m_text, line);
+            m_text.push_back(L']');
+        }
+        if ( fn )
+        {
+            m_fn = fn;
+            m_text.push_back(L' ');
+            m_text.append_ascii(fn, m_fn.size());
+        }
+        m_text.push_back(L':');
+    }
+
+    const uistring& text() const { return m_text; }
+
+    const char* file() const { return m_has_file ? m_file.c_str() : NULL; }
+    int line() const { return m_line; }
+    const char* fn() const { return m_has_fn ? m_fn.c_str() : NULL; }
+
+    // Writes site definition once per binary log file
+    boost::uint32_t binary_id() const
+    {
+        const unsigned generation = detail::log_binary_generation();
+        if ( generation && m_generation.exchange(generation) != generation )
+        {
+            detail::log_binary_write_site(m_id, file(), m_line, fn());
+        }
+        return m_id;
+    }
+
+    // Token bucket in the form of generic cell rate algorithm:
+    // m_arrival is theoretical arrival time of the next message
+    bool acquire_token(boost::uint64_t now, boost::uint64_t interval,
+                       unsigned burst) const
+    {
+        const boost::uint64_t tolerance = interval * (burst > 1 ? burst - 1 : 0);
+
+        boost::uint64_t arrival = m_arrival.load(boost::memory_order_relaxed);
+        for ( ;; )
+        {
+            const boost::uint64_t start = arrival > now ? arrival : now;
+            if ( start - now > tolerance )
+            {
+                m_rate_limited.fetch_add(1, boost::memory_order_relaxed);
+                return false;
+            }
+
+            if ( m_arrival.compare_exchange_weak(arrival, start + interval,
+                                                 boost::memory_order_relaxed) )
+                return true;
+        }
+    }
+
+    // Returns count of messages that were rate limited since the previous call
+    unsigned long long take_rate_limited() const
+    {
+        return m_rate_limited.exchange(0, boost::memory_order_relaxed);
+    }
+
+    // Returns false if message is the same as the previous one,
+    // sets @a repeats to count of collapsed repeats of the previous message
+    bool check_repeat(std::size_t hash, int level, unsigned long long& repeats) const
+    {
+        wxMutexLocker lock(m_repeats_mutex);
+
+        if ( hash == m_last_hash && level == m_last_level )
+        {
+            m_repeats++;
+            return false;
+        }
+
+        repeats = m_repeats;
+        m_repeats = 0;
+        m_last_hash = hash;
+        m_last_level = level;
+        return true;
+    }
+
+    // Returns count of collapsed repeats that weren't logged yet and their @a level,
+    // next same message is still collapsed
+    unsigned long long take_repeats(int& level) const
+    {
+        wxMutexLocker lock(m_repeats_mutex);
+
+        const unsigned long long repeats = m_repeats;
+        m_repeats = 0;
+        level = m_last_level;
+        return repeats;
+    }
+
+private:
+    const boost::uint32_t m_id;
+    const bool m_has_file;
+    int m_line;
+    const bool m_has_fn;
+
+    std::string m_file;
+    std::string m_fn;
+    uistring m_text;
+
+    mutable boost::atomic<unsigned> m_generation;
+
+    mutable boost::atomic<boost::uint64_t> m_arrival;
+    mutable boost::atomic<unsigned long long> m_rate_limited;
+
+    mutable wxMutex m_repeats_mutex;
+    mutable std::size_t m_last_hash;
+    mutable int m_last_level;
+    mutable unsigned long long m_repeats;
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::log_site;
+
+// Contents of the call site location, null strings differ from empty ones.
+// Key doesn't own strings: lookup key refers to strings of the caller,
+// key of the map refers to strings that are copied by its site
+class site_key
+{
+public:
+    site_key(const char* file, int line, const char* fn)
+        : m_file(file), m_fn(fn), m_line(line) {}
+
+    bool operator<(const site_key& other) const
+    {
+        if ( m_line != other.m_line )
+            return m_line < other.m_line;
+        const int file = compare(m_file, other.m_file);
+        if ( file != 0 )
+            return file < 0;
+        return compare(m_fn, other.m_fn) < 0;
+    }
+
+private:
+    static int compare(const char* a, const char* b)
+    {
+        if ( !a || !b )
+            return (a ? 1 : 0) - (b ? 1 : 0);
+        return std::strcmp(a, b);
+    }
+
+    const char* m_file;
+    const char* m_fn;
+    int m_line;
+};
+
+typedef std::map<site_key, log_site*> sites_type;
+
+// Registered sites are never removed, sites with the same contents are shared,
+// so locations that aren't string literals don't add sites on each call
+wxMutex g_sites_mutex;
+sites_type g_sites;
+
+const log_site& find_site(const char* file, int line, const char* fn)
+{
+    const site_key key(file, line, fn);
+
+    wxMutexLocker lock(g_sites_mutex);
+
+    sites_type::iterator iter = g_sites.lower_bound(key);
+    if ( iter != g_sites.end() && !(key < iter->first) )
+        return *iter->second;
+
+    // Strings are copied only when new site is added
+    log_site* site = new log_site(static_cast<boost::uint32_t>(g_sites.size()), file, line, fn);
+    g_sites.insert(iter, sites_type::value_type(site_key(site->file(), line, site->fn()), site));
+    return *site;
+}
+
+// Notice about collapsed messages of the call site
+void log_repeats(log& l, const log_site& site, unsigned long long repeats)
+{
+    l.noquotes().raw(site.text()) << L"Last message repeated" << repeats << L"times";
+}
+
+// Per-thread direct-mapped cache of literal call sites, size is power of two.
+// Addresses of string literals identify their contents,
+// so cache hit doesn't compare strings
+struct site_cache_entry
+{
+    const char* file;
+    int line;
+    const char* fn;
+    const log_site* site;
+};
+
+const std::size_t sites_cache_size = 256;
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+thread_local site_cache_entry t_sites_cache[sites_cache_size];
+#define BOOST_UI_SITES_CACHE t_sites_cache
+#else
+wxTLS_TYPE(site_cache_entry*) t_sites_cache;
+#define BOOST_UI_SITES_CACHE sites_cache()
+
+site_cache_entry* sites_cache()
+{
+    site_cache_entry*& cache = wxTLS_VALUE(t_sites_cache);
+    if ( !cache )
+    {
+        cache = new site_cache_entry[sites_cache_size];
+        const site_cache_entry empty = { NULL, 0, NULL, NULL };
+        std::fill(cache, cache + sites_cache_size, empty);
+    }
+    return cache;
+}
+#endif
+
+const log_site& find_literal_site(const detail::log_literal_site& location)
+{
+    const std::size_t hash = reinterpret_cast<std::size_t>(location.file) / sizeof(void*) * 31 +
+                             static_cast<std::size_t>(location.line);
+
+    site_cache_entry& entry = BOOST_UI_SITES_CACHE[hash % sites_cache_size];
+    if ( !entry.site || entry.file != location.file ||
+         entry.line != location.line || entry.fn != location.fn )
+    {
+        entry.site = &find_site(location.file, location.line, location.fn);
+        entry.file = location.file;
+        entry.line = location.line;
+        entry.fn   = location.fn;
+    }
+
+    return *entry.site;
+}
+
+#undef BOOST_UI_SITES_CACHE
+
+template <class T>
+void write_binary(detail::log_binary_buffer& buf, detail::log_binary_tag tag,
+                  bool spaces, bool quotes, const T& value)
+{
+    buf.tag(tag, spaces, quotes);
+    buf.value(value);
+}
+
+template <class Char>
+void write_binary_string(detail::log_binary_buffer& buf, detail::log_binary_tag tag,
+                         bool spaces, bool quotes, const Char* str, std::size_t length)
+{
+    buf.tag(tag, spaces, quotes);
+    buf.string(str, length);
+}
+
+} // unnamed namespace
+
 log_string::log_string(uistring& str)
-    : m_string(str), m_spaces(true), m_quotes(true)
+    : m_string(str), m_binary(NULL), m_site(NULL), m_spaces(true), m_quotes(true)
 {
 }
 
 log_string& log_string::location(const char* file, int line, const char* fn)
 {
-    std::ostringstream ss;
+    return append_location(find_site(file, line, fn));
+}
 
-    if ( file )
-        ss << file;
-    if ( line >= 0 )
-        ss << '[' << line << ']';
-    if ( fn )
-        ss << ' ' << fn;
+log_string& log_string::location(const detail::log_literal_site& location)
+{
+    return append_location(find_literal_site(location));
+}
 
-    ss << ":";
+log_string& log_string::append_location(const log_site& site)
+{
+    m_site = &site;
 
-    m_string.append(ascii(ss.str()));
+    if ( m_binary )
+        write_binary(*m_binary, detail::log_binary_location,
+                     m_spaces, m_quotes, site.binary_id());
+    else
+        m_string.append(site.text());
 
     return *this;
 }
@@ -41,13 +382,115 @@ log_string& log_string::location(const char* file, int line, const char* fn)
 void log_string::append_space()
 {
     if ( m_spaces && !m_string.empty() )
-        m_string.append(wxS(" "));
+        m_string.push_back(L' ');
+}
+
+void log_string::append_narrow(const char* str, std::size_t length)
+{
+    for ( std::size_t i = 0; i < length; i++ )
+    {
+        if ( static_cast<unsigned char>(str[i]) >= 0x80 )
+        {
+            // Non-ASCII characters are converted using current locale encoding
+            m_string.append(uistring(std::string(str, length)));
+            return;
+        }
+    }
+
+    m_string.append_ascii(str, length);
+}
+
+void log_string::append_wide(const wchar_t* str, std::size_t length)
+{
+    if ( m_binary )
+    {
+        write_binary_string(*m_binary, detail::log_binary_wstring,
+                            m_spaces, m_quotes, str, length);
+        return;
+    }
+
+    if ( m_quotes || length > 0 )
+        append_space();
+
+    if ( m_quotes )
+        m_string.push_back(L'"');
+
+    m_string.append(str, length);
+
+    if ( m_quotes )
+        m_string.push_back(L'"');
+}
+
+void log_string::raw(detail::log_streambuf& buf)
+{
+    if ( m_binary )
+    {
+        m_binary->tag(detail::log_binary_raw_string, m_spaces, m_quotes);
+        buf.append_to(*m_binary);
+        return;
+    }
+
+    if ( m_quotes || !buf.empty() )
+        append_space();
+
+    buf.append_to(m_string);
+}
+
+namespace {
+
+detail::log_binary_tag binary_floating_tag(float)
+    { return detail::log_binary_float; }
+detail::log_binary_tag binary_floating_tag(double)
+    { return detail::log_binary_double; }
+detail::log_binary_tag binary_floating_tag(long double)
+    { return detail::log_binary_long_double; }
+
+} // unnamed namespace
+
+template <class T>
+log_string& log_string::append_integer(T value)
+{
+    if ( m_binary )
+    {
+        if ( std::numeric_limits<T>::is_signed )
+            write_binary(*m_binary, detail::log_binary_signed,
+                         m_spaces, m_quotes, static_cast<boost::int64_t>(value));
+        else
+            write_binary(*m_binary, detail::log_binary_unsigned,
+                         m_spaces, m_quotes, static_cast<boost::uint64_t>(value));
+        return *this;
+    }
+
+    append_space();
+    detail::append_integer(m_string, value);
+    return *this;
+}
+
+template <class T>
+log_string& log_string::append_floating(T value)
+{
+    if ( m_binary )
+    {
+        write_binary(*m_binary, binary_floating_tag(value),
+                     m_spaces, m_quotes, value);
+        return *this;
+    }
+
+    append_space();
+    detail::append_floating(m_string, value, chars_format::general, -1);
+    return *this;
 }
 
 #ifndef BOOST_UI_NO_CAST_FROM_ASCII
 
 log_string& log_string::operator<<(char value)
 {
+    if ( m_binary )
+    {
+        write_binary(*m_binary, detail::log_binary_char, m_spaces, m_quotes, value);
+        return *this;
+    }
+
     append_space();
 
     if ( m_quotes )
@@ -61,18 +504,50 @@ log_string& log_string::operator<<(char value)
     return *this;
 }
 
+log_string& log_string::operator<<(const char* value)
+{
+    const std::size_t length = std::strlen(value);
+
+    if ( m_binary )
+    {
+        write_binary_string(*m_binary, detail::log_binary_string,
+                            m_spaces, m_quotes, value, length);
+        return *this;
+    }
+
+    if ( m_quotes || length > 0 )
+        append_space();
+
+    if ( m_quotes )
+        m_string.push_back(L'"');
+
+    append_narrow(value, length);
+
+    if ( m_quotes )
+        m_string.push_back(L'"');
+
+    return *this;
+}
+
 log_string& log_string::operator<<(const std::string& value)
 {
+    if ( m_binary )
+    {
+        write_binary_string(*m_binary, detail::log_binary_string,
+                            m_spaces, m_quotes, value.data(), value.size());
+        return *this;
+    }
+
     if ( m_quotes || !value.empty() )
         append_space();
 
     if ( m_quotes )
-        m_string.push_back('"');
+        m_string.push_back(L'"');
 
-    m_string.append(value);
+    append_narrow(value.data(), value.size());
 
     if ( m_quotes )
-        m_string.push_back('"');
+        m_string.push_back(L'"');
 
     return *this;
 }
@@ -81,6 +556,13 @@ log_string& log_string::operator<<(const std::string& value)
 
 log_string& log_string::operator<<(wchar_t value)
 {
+    if ( m_binary )
+    {
+        write_binary(*m_binary, detail::log_binary_wchar,
+                     m_spaces, m_quotes, static_cast<boost::uint32_t>(value));
+        return *this;
+    }
+
     append_space();
 
     if ( m_quotes )
@@ -94,8 +576,28 @@ log_string& log_string::operator<<(wchar_t value)
     return *this;
 }
 
+log_string& log_string::operator<<(const wchar_t* value)
+{
+    append_wide(value, std::wcslen(value));
+    return *this;
+}
+
 log_string& log_string::operator<<(const std::wstring& value)
 {
+    append_wide(value.data(), value.size());
+    return *this;
+}
+
+log_string& log_string::operator<<(const uistring& value)
+{
+    if ( m_binary )
+    {
+        const wxString& str = native::from_uistring_ref(value);
+        write_binary_string(*m_binary, detail::log_binary_wstring,
+                            m_spaces, m_quotes, str.wc_str(), str.length());
+        return *this;
+    }
+
     if ( m_quotes || !value.empty() )
         append_space();
 
@@ -110,24 +612,59 @@ log_string& log_string::operator<<(const std::wstring& value)
     return *this;
 }
 
-log_string& log_string::operator<<(const uistring& value)
+log_string& log_string::operator<<(bool value)
 {
-    if ( m_quotes || !value.empty() )
-        append_space();
-
-    if ( m_quotes )
-        m_string.push_back('"');
+    if ( m_binary )
+    {
+        write_binary(*m_binary, detail::log_binary_bool, m_spaces, m_quotes,
+                     static_cast<boost::uint8_t>(value));
+        return *this;
+    }
 
-    m_string.append(value);
+    append_space();
 
-    if ( m_quotes )
-        m_string.push_back('"');
+    if ( value )
+        m_string.append_ascii("true", 4);
+    else
+        m_string.append_ascii("false", 5);
 
     return *this;
 }
 
+log_string& log_string::operator<<(short value)
+    { return append_integer(value); }
+log_string& log_string::operator<<(unsigned short value)
+    { return append_integer(value); }
+log_string& log_string::operator<<(int value)
+    { return append_integer(value); }
+log_string& log_string::operator<<(unsigned int value)
+    { return append_integer(value); }
+log_string& log_string::operator<<(long value)
+    { return append_integer(value); }
+log_string& log_string::operator<<(unsigned long value)
+    { return append_integer(value); }
+log_string& log_string::operator<<(long long value)
+    { return append_integer(value); }
+log_string& log_string::operator<<(unsigned long long value)
+    { return append_integer(value); }
+
+log_string& log_string::operator<<(float value)
+    { return append_floating(value); }
+log_string& log_string::operator<<(double value)
+    { return append_floating(value); }
+log_string& log_string::operator<<(long double value)
+    { return append_floating(value); }
+
 log_string&  log_string::raw(const uistring& value)
 {
+    if ( m_binary )
+    {
+        const wxString& str = native::from_uistring_ref(value);
+        write_binary_string(*m_binary, detail::log_binary_raw_wstring,
+                            m_spaces, m_quotes, str.wc_str(), str.length());
+        return *this;
+    }
+
     if ( m_quotes || !value.empty() )
         append_space();
 
@@ -136,37 +673,1035 @@ log_string&  log_string::raw(const uistring& value)
     return *this;
 }
 
-log::~log()
+namespace {
+
+// Each record occupies one or more consecutive fixed-size slots
+const std::size_t slot_size = 256;
+const std::size_t slot_header_size = 16;
+const std::size_t slot_chars = (slot_size - slot_header_size) / sizeof(wchar_t);
+
+// Count of slots in the ring buffer of each thread, power of two
+const std::size_t ring_slots = 256;
+
+// Consumer thread sleeps this time when all ring buffers are empty
+const unsigned long idle_timeout_ms = 10;
+
+// Pending notices of collapsed repeats are logged with this period
+const boost::uint64_t repeats_period_us = 1000000;
+
+struct log_slot
 {
-    flush();
+    boost::uint64_t timestamp; // Milliseconds since the Epoch
+    boost::uint32_t level;     // wxLogLevel
+    boost::uint16_t slots;     // Count of slots of the record
+    boost::uint16_t length;    // Count of characters in this slot
+    wchar_t text[slot_chars];
+};
+
+// Single producer, single consumer ring buffer
+class log_ring : private boost::noncopyable
+{
+public:
+    log_ring() : m_next(NULL), m_head(0), m_tail(0), m_dropped(0),
+                 m_abandoned(false) {}
+
+    // Called from the owner thread only
+    bool push(wxLogLevel level, boost::uint64_t timestamp,
+              const wchar_t* str, std::size_t length)
+    {
+        std::size_t count = length ? (length + slot_chars - 1) / slot_chars : 1;
+        if ( count > ring_slots )
+        {
+            count = ring_slots;
+            length = ring_slots * slot_chars;
+        }
+
+        const std::size_t head = m_head.load(boost::memory_order_relaxed);
+        const std::size_t tail = m_tail.load(boost::memory_order_acquire);
+        if ( head - tail + count > ring_slots )
+        {
+            // Only the owner thread writes the counter
+            m_dropped.store(m_dropped.load(boost::memory_order_relaxed) + 1,
+                            boost::memory_order_relaxed);
+            return false;
+        }
+
+        for ( std::size_t i = 0; i < count; i++ )
+        {
+            log_slot& slot = m_slots[(head + i) % ring_slots];
+            const std::size_t offset = i * slot_chars;
+            const std::size_t n = (std::min)(length - offset, slot_chars);
+
+            slot.timestamp = timestamp;
+            slot.level     = static_cast<boost::uint32_t>(level);
+            slot.slots     = static_cast<boost::uint16_t>(count);
+            slot.length    = static_cast<boost::uint16_t>(n);
+            std::memcpy(slot.text, str + offset, n * sizeof(wchar_t));
+        }
+
+        m_head.store(head + count, boost::memory_order_release);
+        return true;
+    }
+
+    // Called from the consumer thread only
+    template <class Target>
+    std::size_t pop_all(Target& target, wxString& buffer)
+    {
+        std::size_t tail = m_tail.load(boost::memory_order_relaxed);
+        const std::size_t head = m_head.load(boost::memory_order_acquire);
+
+        std::size_t count = 0;
+        while ( tail != head )
+        {
+            const log_slot& first = m_slots[tail % ring_slots];
+
+            buffer.clear();
+            for ( std::size_t i = 0; i < first.slots; i++ )
+            {
+                const log_slot& slot = m_slots[(tail + i) % ring_slots];
+                buffer.append(slot.text, slot.length);
+            }
+
+            target.deliver(static_cast<wxLogLevel>(first.level), first.timestamp, buffer);
+
+            tail += first.slots;
+            count++;
+        }
+
+        m_tail.store(tail, boost::memory_order_release);
+        return count;
+    }
+
+    unsigned long long dropped() const
+    {
+        return m_dropped.load(boost::memory_order_relaxed);
+    }
+
+    void abandon() { m_abandoned.store(true, boost::memory_order_release); }
+    bool abandoned() const { return m_abandoned.load(boost::memory_order_acquire); }
+
+    log_ring* m_next; // Guarded by g_rings_mutex
+
+private:
+    boost::atomic<std::size_t> m_head;
+    boost::atomic<std::size_t> m_tail;
+    boost::atomic<unsigned long long> m_dropped;
+    boost::atomic<bool> m_abandoned;
+
+    log_slot m_slots[ring_slots];
+};
+
+wxMutex g_rings_mutex;
+log_ring* g_rings = NULL;
+
+boost::atomic<bool> g_running(false);
+boost::atomic<unsigned long long> g_delivered(0);
+
+// Count of threads that may use the consumer, stop() waits for them
+// after clearing g_running, so the consumer isn't deleted under them
+boost::atomic<unsigned> g_producers(0);
+
+class producer_guard : private boost::noncopyable
+{
+public:
+    producer_guard() { g_producers.fetch_add(1); }
+    ~producer_guard() { g_producers.fetch_sub(1); }
+};
+boost::atomic<unsigned long long> g_dropped(0); // Of removed ring buffers
+
+log_ring* register_ring()
+{
+    log_ring* ring = new log_ring;
+
+    wxMutexLocker lock(g_rings_mutex);
+    ring->m_next = g_rings;
+    g_rings = ring;
+
+    return ring;
 }
 
-void log::flush()
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+
+// Marks ring buffer of finished thread to be removed after draining
+class thread_ring
 {
+public:
+    thread_ring() : m_ring(NULL) {}
+
+    ~thread_ring()
+    {
+        if ( m_ring )
+            m_ring->abandon();
+    }
+
+    log_ring* get()
+    {
+        if ( !m_ring )
+            m_ring = register_ring();
+        return m_ring;
+    }
+
+private:
+    log_ring* m_ring;
+};
+
+thread_local thread_ring t_ring;
+
+log_ring* current_ring()
+{
+    return t_ring.get();
+}
+
+#else
+
+// Ring buffers of finished threads are kept
+wxTLS_TYPE(log_ring*) t_ring;
+
+log_ring* current_ring()
+{
+    log_ring*& ring = wxTLS_VALUE(t_ring);
+    if ( !ring )
+        ring = register_ring();
+    return ring;
+}
+
+#endif
+
+const wxChar* level_name(wxLogLevel level)
+{
+    switch ( level )
+    {
+        case wxLOG_FatalError: return wxS("Fatal");
+        case wxLOG_Error:      return wxS("Error");
+        case wxLOG_Warning:    return wxS("Warning");
+        case wxLOG_Message:    return wxS("Info");
+        case wxLOG_Info:       return wxS("Verbose");
+        case wxLOG_Debug:      return wxS("Debug");
+        default:               return wxS("Trace");
+    }
+}
+
+class log_target : private boost::noncopyable
+{
+public:
+    virtual ~log_target() {}
+
+    // Keeps all fatal messages synchronous if false
+    virtual bool accepts_fatal() const { return false; }
+
+    virtual void deliver(wxLogLevel level, boost::uint64_t timestamp,
+                         const wxString& message) = 0;
+    virtual void flush() {}
+};
+
+class native_log_target : public log_target
+{
+public:
+    virtual void deliver(wxLogLevel level, boost::uint64_t timestamp,
+                         const wxString& message) wxOVERRIDE
+    {
+        if ( level == wxLOG_Info && !wxLog::GetVerbose() )
+            return;
+#if !wxDEBUG_LEVEL
+        if ( level == wxLOG_Debug || level == wxLOG_Trace )
+            return;
+#endif
+
+        // wxLog buffers messages of secondary threads for the main thread
+        wxLog::OnLog(level, message, static_cast<time_t>(timestamp / 1000));
+    }
+};
+
+class file_log_target : public log_target
+{
+public:
+    explicit file_log_target(const wxString& filename)
+        : m_file(filename, wxS("a")) {}
+
+    bool is_opened() const { return m_file.IsOpened(); }
+
+    virtual bool accepts_fatal() const wxOVERRIDE { return true; }
+
+    virtual void deliver(wxLogLevel level, boost::uint64_t timestamp,
+                         const wxString& message) wxOVERRIDE
+    {
+        const wxDateTime time(wxLongLong(static_cast<wxLongLong_t>(timestamp)));
+
+        m_line = time.Format(wxS("%Y-%m-%d %H:%M:%S.%l "));
+        m_line << level_name(level) << wxS(": ") << message << wxS('\n');
+
+        m_file.Write(m_line, wxConvUTF8);
+    }
+
+    virtual void flush() wxOVERRIDE
+    {
+        m_file.Flush();
+    }
+
+private:
+    wxFFile m_file;
+    wxString m_line;
+};
+
+class log_consumer : public wxThread
+{
+public:
+    explicit log_consumer(log_target* target)
+        : wxThread(wxTHREAD_JOINABLE), m_target(target),
+          m_stopping(false), m_passes(0), m_passes_condition(m_passes_mutex) {}
+
+    const log_target& target() const { return *m_target; }
+
+    void stop()
+    {
+        m_stopping.store(true, boost::memory_order_release);
+        m_wakeup.Post();
+        Wait();
+    }
+
+    // Waits until the pass that starts after the call is finished
+    void flush()
+    {
+        wxMutexLocker lock(m_passes_mutex);
+        const unsigned long long target = m_passes + 2;
+        m_wakeup.Post();
+        while ( m_passes < target && IsRunning() )
+            m_passes_condition.WaitTimeout(idle_timeout_ms);
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        wxString buffer;
+        boost::uint64_t repeats_time = native::event_trace_now();
+        for ( ;; )
+        {
+            const bool stopping = m_stopping.load(boost::memory_order_acquire);
+
+            // Notices are pushed into the ring buffer of this thread
+            const boost::uint64_t now = native::event_trace_now();
+            if ( !stopping && now - repeats_time >= repeats_period_us )
+            {
+                repeats_time = now;
+                log::flush_repeats();
+            }
+
+            const std::size_t count = drain(buffer);
+
+            {
+                wxMutexLocker lock(m_passes_mutex);
+                ++m_passes;
+                m_passes_condition.Broadcast();
+            }
+
+            if ( stopping )
+                break;
+
+            if ( count == 0 )
+                m_wakeup.WaitTimeout(idle_timeout_ms);
+        }
+        return 0;
+    }
+
+private:
+    // Ring buffers are delivered outside of the mutex,
+    // so new threads can register their buffers meanwhile.
+    // Only this thread removes buffers from the list
+    std::size_t drain(wxString& buffer)
+    {
+        m_rings.clear();
+        {
+            wxMutexLocker lock(g_rings_mutex);
+            for ( log_ring* ring = g_rings; ring; ring = ring->m_next )
+                m_rings.push_back(ring);
+        }
+
+        std::size_t count = 0;
+        bool has_abandoned = false;
+        for ( std::size_t i = 0; i < m_rings.size(); i++ )
+        {
+            // Owner thread doesn't push anything after abandoning
+            const bool abandoned = m_rings[i]->abandoned();
+            count += m_rings[i]->pop_all(*m_target, buffer);
+
+            if ( abandoned )
+                has_abandoned = true;
+            else
+                m_rings[i] = NULL;
+        }
+
+        if ( has_abandoned )
+            remove_rings();
+
+        if ( count )
+        {
+            m_target->flush();
+            g_delivered.fetch_add(count, boost::memory_order_relaxed);
+        }
+
+        return count;
+    }
+
+    // Removes drained abandoned buffers that remain in m_rings
+    void remove_rings()
+    {
+        wxMutexLocker lock(g_rings_mutex);
+        for ( std::size_t i = 0; i < m_rings.size(); i++ )
+        {
+            log_ring* ring = m_rings[i];
+            if ( !ring )
+                continue;
+
+            log_ring** link = &g_rings;
+            while ( *link != ring )
+                link = &(*link)->m_next;
+            *link = ring->m_next;
+
+            g_dropped.fetch_add(ring->dropped(), boost::memory_order_relaxed);
+            delete ring;
+        }
+    }
+
+    boost::scoped_ptr<log_target> m_target;
+    std::vector<log_ring*> m_rings;
+    boost::atomic<bool> m_stopping;
+    wxSemaphore m_wakeup;
+
+    wxMutex m_passes_mutex;
+    unsigned long long m_passes;
+    wxCondition m_passes_condition;
+};
+
+log_consumer* g_consumer = NULL;
+
+bool start_consumer(log_target* target)
+{
+    async_log::stop();
+
+    log_consumer* consumer = new log_consumer(target);
+    if ( consumer->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete consumer;
+        wxFAIL_MSG(wxS("Unable to start log thread"));
+        return false;
+    }
+
+    g_consumer = consumer;
+    g_running.store(true, boost::memory_order_release);
+    return true;
+}
+
+} // unnamed namespace
+
+#ifndef DOXYGEN
+
+class async_log_detail
+{
+public:
+    static wxLogLevel native_level(log::level_values level)
+    {
+        switch ( level )
+        {
+            case log::fatal_level:   return wxLOG_FatalError;
+            case log::error_level:   return wxLOG_Error;
+            case log::warning_level: return wxLOG_Warning;
+            case log::info_level:    return wxLOG_Message;
+            case log::verbose_level: return wxLOG_Info;
+            case log::debug_level:   return wxLOG_Debug;
+            default:                 return wxLOG_Trace;
+        }
+    }
+
+    // Returns false if message should be logged synchronously
+    static bool push(const log& l)
+    {
+        producer_guard guard;
+        if ( !g_running.load() )
+            return false;
+
+        const bool fatal = l.m_level == log::fatal_level;
+        if ( !fatal || g_consumer->target().accepts_fatal() )
+        {
+            const wxString& str = native::from_uistring_ref(l.buffer());
+            current_ring()->push(native_level(l.m_level),
+                                 wxGetUTCTimeMillis().GetValue(),
+                                 str.wc_str(), str.length());
+        }
+
+        if ( !fatal )
+            return true;
+
+        // Deliver everything before aborting
+        async_log::flush();
+        return false;
+    }
+};
+
+#endif
+
+bool async_log::start()
+{
+    return start_consumer(new native_log_target);
+}
+
+bool async_log::start(const uistring& filename)
+{
+    file_log_target* target = new file_log_target(native::from_uistring(filename));
+    if ( !target->is_opened() )
+    {
+        delete target;
+        return false;
+    }
+
+    return start_consumer(target);
+}
+
+void async_log::stop()
+{
+    if ( !g_consumer )
+        return;
+
+    log::flush_repeats();
+
+    // Producers that have seen the flag finish pushing before the final drain,
+    // later ones log synchronously
+    g_running.store(false);
+    while ( g_producers.load() != 0 )
+        wxThread::Yield();
+
+    g_consumer->stop();
+
+    delete g_consumer;
+    g_consumer = NULL;
+}
+
+bool async_log::running()
+{
+    return g_running.load(boost::memory_order_acquire);
+}
+
+void async_log::flush()
+{
+    log::flush_repeats();
+
+    producer_guard guard;
+    if ( g_running.load() )
+        g_consumer->flush();
+}
+
+unsigned long long async_log::delivered_count()
+{
+    return g_delivered.load(boost::memory_order_relaxed);
+}
+
+unsigned long long async_log::dropped_count()
+{
+    unsigned long long result = g_dropped.load(boost::memory_order_relaxed);
+
+    wxMutexLocker lock(g_rings_mutex);
+    for ( const log_ring* ring = g_rings; ring; ring = ring->m_next )
+        result += ring->dropped();
+
+    return result;
+}
+
+namespace {
+
+// Count of simultaneously alive logs in a thread that reuse buffers
+const std::size_t log_buffers_count = 4;
+
+struct log_buffer
+{
+    uistring text;
+    detail::log_binary_buffer binary;
+};
+
+class log_buffers : private boost::noncopyable
+{
+public:
+    log_buffers()
+    {
+        std::fill(m_buffers, m_buffers + log_buffers_count,
+                  static_cast<log_buffer*>(NULL));
+        std::fill(m_used, m_used + log_buffers_count, false);
+    }
+
+    ~log_buffers()
+    {
+        for ( std::size_t i = 0; i < log_buffers_count; i++ )
+            delete m_buffers[i];
+    }
+
+    log_buffer* acquire()
+    {
+        for ( std::size_t i = 0; i < log_buffers_count; i++ )
+        {
+            if ( m_used[i] )
+                continue;
+
+            if ( !m_buffers[i] )
+                m_buffers[i] = new log_buffer;
+
+            m_used[i] = true;
+            return m_buffers[i];
+        }
+        return NULL;
+    }
+
+    log_buffer* find(const uistring& str)
+    {
+        const std::size_t i = index(str);
+        return i < log_buffers_count ? m_buffers[i] : NULL;
+    }
+
+    bool release(const uistring& str)
+    {
+        const std::size_t i = index(str);
+        if ( i == log_buffers_count )
+            return false;
+
+        // Keep capacity for the next log
+        m_buffers[i]->text.clear();
+        m_buffers[i]->binary.clear();
+        m_used[i] = false;
+        return true;
+    }
+
+private:
+    std::size_t index(const uistring& str) const
+    {
+        std::size_t i = 0;
+        while ( i < log_buffers_count &&
+                !(m_buffers[i] && &m_buffers[i]->text == &str) )
+            i++;
+        return i;
+    }
+
+    log_buffer* m_buffers[log_buffers_count];
+    bool m_used[log_buffers_count];
+};
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+
+thread_local bool t_buffers_destroyed = false;
+
+// Logs from destructors of other thread local objects use heap buffers
+class thread_buffers
+{
+public:
+    ~thread_buffers() { t_buffers_destroyed = true; }
+
+    log_buffers* get() { return t_buffers_destroyed ? NULL : &m_buffers; }
+
+private:
+    log_buffers m_buffers;
+};
+
+thread_local thread_buffers t_buffers;
+
+log_buffers* current_buffers()
+{
+    return t_buffers.get();
+}
+
+#else
+
+// Buffers of finished threads are kept
+wxTLS_TYPE(log_buffers*) t_buffers;
+
+log_buffers* current_buffers()
+{
+    log_buffers*& buffers = wxTLS_VALUE(t_buffers);
+    if ( !buffers )
+        buffers = new log_buffers;
+    return buffers;
+}
+
+#endif
+
+} // unnamed namespace
+
+uistring& log::acquire_buffer()
+{
+    log_buffers* buffers = current_buffers();
+    log_buffer* buf = buffers ? buffers->acquire() : NULL;
+    return buf ? buf->text : *new uistring;
+}
+
+void log::release_buffers()
+{
+    const uistring& str = buffer();
+
+    log_buffers* buffers = current_buffers();
+    if ( !buffers || !buffers->release(str) )
+        delete &str;
+}
+
+log::log() : log_string(acquire_buffer()), m_level(debug_level)
+{
+    init();
+}
+
+log::log(level_values level) : log_string(acquire_buffer()), m_level(level)
+{
+    init();
+}
+
+void log::init()
+{
+    // Fatal messages are shown before aborting
+    if ( m_level == fatal_level || !detail::log_binary_generation() )
+        return;
+
+    log_buffers* buffers = current_buffers();
+    log_buffer* buf = buffers ? buffers->find(buffer()) : NULL;
+    if ( buf )
+        binary(&buf->binary);
+}
+
+namespace {
+
+boost::atomic<int> g_min_level(BOOST_UI_LOG_LEVEL_TRACE);
+
+const int levels_count = BOOST_UI_LOG_LEVEL_TRACE + 1;
+
+// Per level settings of call site filters, zero interval means unlimited rate
+boost::atomic<boost::uint64_t> g_rate_interval[levels_count];
+boost::atomic<unsigned> g_rate_burst[levels_count];
+boost::atomic<bool> g_collapse[levels_count];
+
+boost::atomic<unsigned long long> g_rate_limited(0);
+boost::atomic<unsigned long long> g_repeated(0);
+boost::atomic<unsigned long long> g_repeated_flushed(0); // Value of g_repeated
+
+bool is_filtered_level(int level)
+{
+    return level > BOOST_UI_LOG_LEVEL_FATAL && level <= BOOST_UI_LOG_LEVEL_TRACE;
+}
+
+// FNV-1a hash of message text or encoded arguments,
+// collisions only collapse different messages
+const std::size_t hash_basis = sizeof(std::size_t) > 4 ?
+    static_cast<std::size_t>(14695981039346656037ULL) : 2166136261U;
+const std::size_t hash_prime = sizeof(std::size_t) > 4 ?
+    static_cast<std::size_t>(1099511628211ULL) : 16777619U;
+
+std::size_t hash_text(const wxString& str)
+{
+    std::size_t hash = hash_basis;
+    for ( wxString::const_iterator iter = str.begin(); iter != str.end(); ++iter )
+        hash = (hash ^ static_cast<std::size_t>((*iter).GetValue())) * hash_prime;
+    return hash;
+}
+
+std::size_t hash_bytes(const char* data, std::size_t size)
+{
+    std::size_t hash = hash_basis;
+    for ( std::size_t i = 0; i < size; i++ )
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * hash_prime;
+    return hash;
+}
+
+typedef std::vector<detail::log_sink*> sinks_type;
+
+// Immutable list of sinks is replaced on each change, messages don't lock.
+// Readers are counted by parity of the epoch they started in,
+// writer waits for both parities in turn, so new readers don't starve it
+wxMutex g_sinks_mutex; // Serializes changes
+boost::atomic<const sinks_type*> g_sinks(NULL);
+boost::atomic<unsigned> g_sinks_epoch(0);
+boost::atomic<unsigned> g_sinks_readers[2];
+
+class sinks_reader : private boost::noncopyable
+{
+public:
+    sinks_reader() : m_epoch(g_sinks_epoch.load() & 1)
+    {
+        g_sinks_readers[m_epoch].fetch_add(1);
+    }
+
+    ~sinks_reader()
+    {
+        g_sinks_readers[m_epoch].fetch_sub(1);
+    }
+
+private:
+    const unsigned m_epoch;
+};
+
+void write_sinks(int level, const uistring& text)
+{
+    if ( !g_sinks.load(boost::memory_order_relaxed) )
+        return;
+
+    sinks_reader reader;
+
+    const sinks_type* sinks = g_sinks.load();
+    if ( !sinks )
+        return;
+
+    for ( sinks_type::const_iterator iter = sinks->begin(); iter != sinks->end(); ++iter )
+        (*iter)->write(level, text);
+}
+
+// Called under g_sinks_mutex, empty list is published as null pointer.
+// Reader that registers after the wait for its parity loads the new list
+void publish_sinks(sinks_type* sinks)
+{
+    if ( sinks->empty() )
+    {
+        delete sinks;
+        sinks = NULL;
+    }
+
+    const sinks_type* old = g_sinks.exchange(sinks);
+    for ( int i = 0; i < 2; i++ )
+    {
+        const unsigned epoch = g_sinks_epoch.fetch_add(1) & 1;
+        while ( g_sinks_readers[epoch].load() != 0 )
+            wxThread::Yield();
+    }
+
+    delete old;
+}
+
+sinks_type* copy_sinks()
+{
+    const sinks_type* sinks = g_sinks.load();
+    return sinks ? new sinks_type(*sinks) : new sinks_type;
+}
+
+} // unnamed namespace
+
+namespace detail {
+
+void add_log_sink(log_sink* sink)
+{
+    wxMutexLocker lock(g_sinks_mutex);
+
+    sinks_type* sinks = copy_sinks();
+    sinks->push_back(sink);
+    publish_sinks(sinks);
+}
+
+void remove_log_sink(log_sink* sink)
+{
+    wxMutexLocker lock(g_sinks_mutex);
+
+    sinks_type* sinks = copy_sinks();
+    sinks->erase(std::remove(sinks->begin(), sinks->end(), sink), sinks->end());
+    publish_sinks(sinks);
+}
+
+} // namespace detail
+
+void log::min_level(int level)
+{
+    wxCHECK_RET(level >= BOOST_UI_LOG_LEVEL_FATAL && level <= BOOST_UI_LOG_LEVEL_TRACE,
+                wxS("Invalid log level"));
+
+    g_min_level.store(level, boost::memory_order_relaxed);
+}
+
+int log::min_level()
+{
+    return g_min_level.load(boost::memory_order_relaxed);
+}
+
+bool log::enabled(int level)
+{
+    return level <= g_min_level.load(boost::memory_order_relaxed);
+}
+
+namespace {
+
+// Returns interval between rate limit tokens of @a level severity or 0
+boost::uint64_t rate_interval(int level)
+{
+    if ( !is_filtered_level(level) )
+        return 0;
+
+    return g_rate_interval[level].load(boost::memory_order_relaxed);
+}
+
+bool acquire_rate_token(int level, boost::uint64_t interval, const log_site& site)
+{
+    // System time adjustments would stop or release rate limited messages
+    const boost::uint64_t now = detail::monotonic_now();
+    if ( site.acquire_token(now, interval,
+             g_rate_burst[level].load(boost::memory_order_relaxed)) )
+        return true;
+
+    g_rate_limited.fetch_add(1, boost::memory_order_relaxed);
+    return false;
+}
+
+} // unnamed namespace
+
+bool log::enabled(int level, const char* file, int line, const char* fn)
+{
+    if ( !enabled(level) )
+        return false;
+
+    const boost::uint64_t interval = rate_interval(level);
+    return !interval || acquire_rate_token(level, interval, find_site(file, line, fn));
+}
+
+bool log::enabled(int level, const detail::log_literal_site& location)
+{
+    if ( !enabled(level) )
+        return false;
+
+    const boost::uint64_t interval = rate_interval(level);
+    return !interval || acquire_rate_token(level, interval, find_literal_site(location));
+}
+
+void log::rate_limit(int level, double per_second, unsigned burst)
+{
+    wxCHECK_RET(is_filtered_level(level), wxS("Invalid log level"));
+    wxCHECK_RET(per_second >= 0, wxS("Invalid log rate"));
+
+    g_rate_burst[level].store(burst ? burst : 1, boost::memory_order_relaxed);
+    // Interval between tokens in microseconds, not less than 1
+    boost::uint64_t interval = 0;
+    if ( per_second > 0 )
+        interval = std::max<boost::uint64_t>(
+            static_cast<boost::uint64_t>(1000000 / per_second), 1);
+
+    g_rate_interval[level].store(interval, boost::memory_order_relaxed);
+}
+
+void log::collapse_repeats(int level, bool collapse)
+{
+    wxCHECK_RET(is_filtered_level(level), wxS("Invalid log level"));
+
+    g_collapse[level].store(collapse, boost::memory_order_relaxed);
+}
+
+unsigned long long log::rate_limited_count()
+{
+    return g_rate_limited.load(boost::memory_order_relaxed);
+}
+
+unsigned long long log::repeated_count()
+{
+    return g_repeated.load(boost::memory_order_relaxed);
+}
+
+void log::flush_repeats()
+{
+    // Nothing was collapsed since the previous call
+    const unsigned long long repeated = g_repeated.load(boost::memory_order_acquire);
+    if ( g_repeated_flushed.exchange(repeated, boost::memory_order_relaxed) == repeated )
+        return;
+
+    std::vector<const log_site*> sites;
+    {
+        wxMutexLocker lock(g_sites_mutex);
+
+        sites.reserve(g_sites.size());
+        for ( sites_type::const_iterator iter = g_sites.begin();
+              iter != g_sites.end(); ++iter )
+            sites.push_back(iter->second);
+    }
+
+    for ( std::size_t i = 0; i < sites.size(); i++ )
+    {
+        int level = 0;
+        const unsigned long long repeats = sites[i]->take_repeats(level);
+        if ( repeats )
+        {
+            log l(static_cast<level_values>(level));
+            log_repeats(l, *sites[i], repeats);
+        }
+    }
+}
+
+log::~log()
+{
+    flush();
+    release_buffers();
+}
+
+bool log::check_site()
+{
+    const detail::log_site* s = site();
+    if ( !s || !is_filtered_level(m_level) )
+        return true;
+
+    if ( g_collapse[m_level].load(boost::memory_order_relaxed) )
+    {
+        const std::size_t hash = binary() ?
+            hash_bytes(binary()->data(), binary()->size()) :
+            hash_text(native::from_uistring_ref(buffer()));
+
+        unsigned long long repeats = 0;
+        if ( !s->check_repeat(hash, m_level, repeats) )
+        {
+            g_repeated.fetch_add(1, boost::memory_order_release);
+            return false;
+        }
+
+        // Notices are logged without location, so they aren't filtered
+        if ( repeats )
+        {
+            log l(m_level);
+            log_repeats(l, *s, repeats);
+        }
+    }
+
+    const unsigned long long rate_limited = s->take_rate_limited();
+    if ( rate_limited )
+    {
+        log(m_level).noquotes().raw(s->text())
+            << rate_limited << L"messages were suppressed by rate limit";
+    }
+
+    return true;
+}
+
+void log::flush()
+{
+    if ( !enabled(m_level) || !check_site() )
+        return;
+
+    if ( binary() )
+    {
+        // Binary log was stopped after the message was encoded
+        if ( !detail::log_binary_write_message(m_level, *binary()) )
+            detail::log_binary_drop();
+        return;
+    }
+
+    write_sinks(m_level, buffer());
+
+    if ( async_log_detail::push(*this) )
+        return;
+
     switch ( m_level )
     {
         case fatal_level:
-            wxLogFatalError(wxS("%s"), native::from_uistring(m_string));
+            wxLogFatalError(wxS("%s"), native::from_uistring_ref(buffer()));
             break;
         case error_level:
-            wxLogError(wxS("%s"), native::from_uistring(m_string));
+            wxLogError(wxS("%s"), native::from_uistring_ref(buffer()));
             break;
         case warning_level:
-            wxLogWarning(wxS("%s"), native::from_uistring(m_string));
+            wxLogWarning(wxS("%s"), native::from_uistring_ref(buffer()));
             break;
         case info_level:
-            wxLogMessage(wxS("%s"), native::from_uistring(m_string));
+            wxLogMessage(wxS("%s"), native::from_uistring_ref(buffer()));
             break;
         case verbose_level:
-            wxLogVerbose(wxS("%s"), native::from_uistring(m_string));
+            wxLogVerbose(wxS("%s"), native::from_uistring_ref(buffer()));
             break;
         default:
             wxFAIL_MSG(wxS("Unknown log level"));
         case debug_level:
-            wxLogDebug(wxS("%s"), native::from_uistring(m_string));
+            wxLogDebug(wxS("%s"), native::from_uistring_ref(buffer()));
             break;
         case trace_level:
-            wxLogTrace(wxS("%s"), native::from_uistring(m_string));
+            wxLogTrace(wxS("%s"), native::from_uistring_ref(buffer()));
             break;
     }
 }
@@ -0,0 +1,243 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/log.hpp>
+#include <boost/ui/detail/log_binary.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstring>
+#include <fstream>
+
+#include <wx/debug.h>
+#include <wx/time.h>
+#include <wx/utils.h>
+
+namespace boost {
+namespace ui    {
+
+namespace {
+
+std::size_t align(std::size_t size)
+{
+    return (size + detail::log_binary_alignment - 1) /
+           detail::log_binary_alignment * detail::log_binary_alignment;
+}
+
+// Memory-mapped file with records appended by many threads
+class binary_file : private boost::noncopyable
+{
+public:
+    binary_file(const std::string& filename, std::size_t capacity)
+        : m_offset(align(sizeof(detail::log_binary_file_header)))
+    {
+        {
+            // Resize file, unused tail stays filled with zeros
+            std::filebuf buf;
+            if ( !buf.open(filename.c_str(), std::ios_base::in | std::ios_base::out |
+                                             std::ios_base::trunc | std::ios_base::binary) )
+                return;
+            buf.pubseekoff(capacity - 1, std::ios_base::beg);
+            buf.sputc(0);
+        }
+
+        try
+        {
+            boost::interprocess::file_mapping mapping(filename.c_str(),
+                boost::interprocess::read_write);
+            boost::interprocess::mapped_region region(mapping,
+                boost::interprocess::read_write, 0, capacity);
+            m_region.swap(region);
+        }
+        catch ( boost::interprocess::interprocess_exception& )
+        {
+            return;
+        }
+
+        detail::log_binary_file_header header;
+        std::memcpy(header.magic, detail::log_binary_magic, sizeof header.magic);
+        header.version    = detail::log_binary_version;
+        header.wchar_size = sizeof(wchar_t);
+        header.capacity   = capacity;
+        std::memcpy(data(), &header, sizeof header);
+    }
+
+    bool is_opened() const { return m_region.get_address() != NULL; }
+
+    char* data() { return static_cast<char*>(m_region.get_address()); }
+
+    std::size_t capacity() const { return m_region.get_size(); }
+
+    void flush() { m_region.flush(); }
+
+    // Returns NULL if the file is full
+    char* reserve(std::size_t size)
+    {
+        const std::size_t offset = m_offset.fetch_add(size, boost::memory_order_relaxed);
+        if ( offset > capacity() || size > capacity() - offset )
+            return NULL;
+
+        return data() + offset;
+    }
+
+private:
+    boost::interprocess::mapped_region m_region;
+    boost::atomic<std::size_t> m_offset;
+};
+
+boost::atomic<binary_file*> g_file(NULL);
+boost::atomic<unsigned> g_generation(0);
+boost::atomic<unsigned> g_writers(0);
+boost::atomic<unsigned long long> g_dropped(0);
+unsigned g_last_generation = 0;
+
+bool write_record(detail::log_binary_record_type type, int level,
+                  const char* data, std::size_t data_size)
+{
+    // Sequentially consistent operations don't let stop() unmap
+    // the file between the check and the copy
+    g_writers.fetch_add(1);
+
+    binary_file* file = g_file.load();
+    if ( !file )
+    {
+        g_writers.fetch_sub(1);
+        return false;
+    }
+
+    const std::size_t size = align(sizeof(detail::log_binary_record_header) + data_size);
+    char* p = file->reserve(size);
+    if ( !p )
+    {
+        g_dropped.fetch_add(1, boost::memory_order_relaxed);
+        g_writers.fetch_sub(1);
+        return true;
+    }
+
+    detail::log_binary_record_header header;
+    header.size      = static_cast<boost::uint32_t>(size);
+    header.type      = static_cast<boost::uint16_t>(type);
+    header.level     = static_cast<boost::uint16_t>(level);
+    header.checksum  = 0;
+    header.reserved  = 0;
+    header.timestamp = static_cast<boost::uint64_t>(wxGetUTCTimeUSec().GetValue());
+
+    // Padding is zero because the file is never written twice at the same place
+    if ( data_size )
+        std::memcpy(p + sizeof header, data, data_size);
+    header.checksum = detail::log_binary_checksum(header, p + sizeof header,
+                                                  size - sizeof header);
+
+    const boost::uint32_t record_size = header.size;
+    header.size = 0;
+    std::memcpy(p, &header, sizeof header);
+
+    // Readers of the file skip records with zero size
+    boost::atomic_thread_fence(boost::memory_order_release);
+    std::memcpy(p, &record_size, sizeof record_size);
+
+    g_writers.fetch_sub(1);
+    return true;
+}
+
+} // unnamed namespace
+
+namespace detail {
+
+unsigned log_binary_generation()
+{
+    return g_generation.load(boost::memory_order_acquire);
+}
+
+bool log_binary_write_site(boost::uint32_t id, const char* file,
+                           int line, const char* fn)
+{
+    log_binary_buffer buf;
+    buf.value(id);
+    buf.value(static_cast<boost::int32_t>(line));
+
+    if ( file )
+        buf.string(file, std::strlen(file));
+    else
+        buf.value(log_binary_null);
+
+    if ( fn )
+        buf.string(fn, std::strlen(fn));
+    else
+        buf.value(log_binary_null);
+
+    return write_record(log_binary_site_record, 0, buf.data(), buf.size());
+}
+
+bool log_binary_write_message(int level, const log_binary_buffer& args)
+{
+    return write_record(log_binary_message_record, level,
+                        args.data(), args.size());
+}
+
+void log_binary_drop()
+{
+    g_dropped.fetch_add(1, boost::memory_order_relaxed);
+}
+
+} // namespace detail
+
+bool binary_log::start(const uistring& filename, std::size_t capacity)
+{
+    wxCHECK_MSG(capacity > 64, false, wxS("Too small binary log capacity"));
+
+    stop();
+
+    binary_file* file = new binary_file(filename.string(), capacity);
+    if ( !file->is_opened() )
+    {
+        delete file;
+        return false;
+    }
+
+    // Zero generation means that binary log isn't running
+    if ( ++g_last_generation == 0 )
+        ++g_last_generation;
+
+    g_file.store(file);
+    g_generation.store(g_last_generation, boost::memory_order_release);
+    return true;
+}
+
+void binary_log::stop()
+{
+    binary_file* file = g_file.exchange(NULL);
+    if ( !file )
+        return;
+
+    g_generation.store(0, boost::memory_order_release);
+
+    // Wait for writers that have seen the file
+    while ( g_writers.load() != 0 )
+        wxMilliSleep(1);
+
+    file->flush();
+    delete file;
+}
+
+bool binary_log::running()
+{
+    return g_file.load(boost::memory_order_acquire) != NULL;
+}
+
+unsigned long long binary_log::dropped_count()
+{
+    return g_dropped.load(boost::memory_order_relaxed);
+}
+
+} // namespace ui
+} // namespace boost
@@ -0,0 +1,601 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/log_view.hpp>
+#include <boost/ui/native/string.hpp>
+#include <boost/ui/native/widget.hpp>
+#include <boost/ui/detail/log_sink.hpp>
+#include <boost/ui/detail/memcheck.hpp>
+
+#include <boost/ui/thread.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include <wx/listctrl.h>
+#include <wx/datetime.h>
+#include <wx/time.h>
+#include <wx/timer.h>
+
+#ifndef wxOVERRIDE
+#define wxOVERRIDE
+#endif
+
+namespace boost {
+namespace ui    {
+
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+
+namespace {
+
+// Interval between showing of queued messages
+const int frame_ms = 16;
+
+// Count of messages that can be queued between frames, power of two
+const std::size_t queue_slots = 1024;
+
+// Bounded multiple producer queue of messages, single consumer is the UI thread.
+// Slot strings keep their capacity, so steady logging doesn't allocate.
+// First message after idle period schedules the view timer
+// through allocation-free call_async()
+class message_queue : public boost::enable_shared_from_this<message_queue>,
+                      private detail::async_item, private boost::noncopyable
+{
+public:
+    explicit message_queue(wxTimer* timer)
+        : m_slots(new slot[queue_slots]), m_head(0), m_tail(0), m_dropped(0),
+          m_scheduled(false), m_timer(timer)
+    {
+        call = &message_queue::on_queued;
+        next = NULL;
+
+        for ( std::size_t i = 0; i < queue_slots; i++ )
+            m_slots[i].sequence.store(i, boost::memory_order_relaxed);
+    }
+
+    // Called from any thread, returns false if the queue is full
+    bool push(int level, const wxLongLong& time, const wxString& text)
+    {
+        std::size_t pos = m_head.load(boost::memory_order_relaxed);
+        slot* s;
+        for ( ;; )
+        {
+            s = &m_slots[pos % queue_slots];
+            const std::size_t sequence = s->sequence.load(boost::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if ( diff == 0 )
+            {
+                if ( m_head.compare_exchange_weak(pos, pos + 1, boost::memory_order_relaxed) )
+                    break;
+            }
+            else if ( diff < 0 )
+            {
+                m_dropped.fetch_add(1, boost::memory_order_relaxed);
+                return false;
+            }
+            else
+                pos = m_head.load(boost::memory_order_relaxed);
+        }
+
+        s->level = level;
+        s->time  = time;
+        s->text  = text;
+        s->sequence.store(pos + 1, boost::memory_order_release);
+
+        if ( !m_scheduled.exchange(true) )
+        {
+            m_self = shared_from_this();
+            detail::call_async(static_cast<detail::async_item*>(this));
+        }
+        return true;
+    }
+
+    // Called from the UI thread, takes slot text
+    template <class Record>
+    bool pop(Record& r)
+    {
+        slot& s = m_slots[m_tail % queue_slots];
+        if ( s.sequence.load(boost::memory_order_acquire) != m_tail + 1 )
+            return false;
+
+        r.level = s.level;
+        r.time  = s.time;
+        r.text.swap(s.text);
+        s.sequence.store(m_tail + queue_slots, boost::memory_order_release);
+        ++m_tail;
+        return true;
+    }
+
+    // Called from the UI thread after the queue was emptied,
+    // restarts timer if messages were pushed meanwhile
+    void idle()
+    {
+        // Synchronizes with producer that didn't schedule because flag was set
+        m_scheduled.exchange(false, boost::memory_order_acq_rel);
+
+        const slot& s = m_slots[m_tail % queue_slots];
+        if ( s.sequence.load(boost::memory_order_acquire) == m_tail + 1 &&
+             !m_scheduled.exchange(true) )
+            start_timer();
+    }
+
+    unsigned long long take_dropped()
+    {
+        return m_dropped.exchange(0, boost::memory_order_relaxed);
+    }
+
+    // Called from the UI thread when the view is destroyed
+    void detach() { m_timer = NULL; }
+
+private:
+    struct slot
+    {
+        boost::atomic<std::size_t> sequence;
+        int level;
+        wxLongLong time;
+        wxString text;
+    };
+
+    void start_timer()
+    {
+        if ( m_timer && !m_timer->IsRunning() )
+            m_timer->Start(frame_ms, wxTIMER_ONE_SHOT);
+    }
+
+    static void on_queued(detail::async_item* item)
+    {
+        message_queue* q = static_cast<message_queue*>(item);
+
+        // Keeps the queue alive until the end of the call
+        boost::shared_ptr<message_queue> self;
+        self.swap(q->m_self);
+
+        q->start_timer();
+    }
+
+    boost::scoped_array<slot> m_slots;
+    boost::atomic<std::size_t> m_head;
+    std::size_t m_tail;
+    boost::atomic<unsigned long long> m_dropped;
+
+    // Set while timer is started or is being started
+    boost::atomic<bool> m_scheduled;
+
+    wxTimer* m_timer;
+    boost::shared_ptr<message_queue> m_self;
+};
+
+const wxChar* level_name(int level)
+{
+    switch ( level )
+    {
+        case BOOST_UI_LOG_LEVEL_FATAL:   return wxS("Fatal");
+        case BOOST_UI_LOG_LEVEL_ERROR:   return wxS("Error");
+        case BOOST_UI_LOG_LEVEL_WARNING: return wxS("Warning");
+        case BOOST_UI_LOG_LEVEL_INFO:    return wxS("Info");
+        case BOOST_UI_LOG_LEVEL_VERBOSE: return wxS("Verbose");
+        case BOOST_UI_LOG_LEVEL_DEBUG:   return wxS("Debug");
+        default:                         return wxS("Trace");
+    }
+}
+
+enum columns
+{
+    time_column,
+    level_column,
+    text_column
+};
+
+} // unnamed namespace
+
+// Virtual list control asks only visible rows from the ring buffer
+class log_view::native_impl : public wxListCtrl, public detail::log_sink,
+                              private detail::memcheck
+{
+    typedef native_impl this_type;
+
+public:
+    native_impl(widget& parent, size_type capacity)
+        : wxListCtrl(native::from_widget(parent), wxID_ANY,
+                     wxDefaultPosition, wxDefaultSize,
+                     wxLC_REPORT | wxLC_VIRTUAL),
+          m_records(capacity), m_begin(0), m_end(0),
+          m_min_level(BOOST_UI_LOG_LEVEL_TRACE), m_capturing(false), m_timer(this),
+          m_queue(boost::make_shared<message_queue>(&m_timer))
+    {
+        InsertColumn(time_column,  wxS("Time"),    wxLIST_FORMAT_LEFT, 100);
+        InsertColumn(level_column, wxS("Level"),   wxLIST_FORMAT_LEFT, 70);
+        InsertColumn(text_column,  wxS("Message"), wxLIST_FORMAT_LEFT, 600);
+
+        m_error_attr.SetTextColour(*wxRED);
+        m_warning_attr.SetTextColour(wxColour(0xC0, 0x60, 0x00));
+
+        // Timer is started by the first message after idle period
+        Bind(wxEVT_TIMER, &this_type::on_timer, this);
+    }
+
+    virtual ~native_impl()
+    {
+        capture(false);
+        m_queue->detach();
+    }
+
+    // Called from any thread
+    virtual void write(int level, const uistring& text) wxOVERRIDE
+    {
+        m_queue->push(level, wxGetUTCTimeMillis(), native::from_uistring_ref(text));
+    }
+
+    void capture(bool enable)
+    {
+        if ( enable == m_capturing )
+            return;
+
+        if ( enable )
+            detail::add_log_sink(this);
+        else
+            detail::remove_log_sink(this);
+
+        m_capturing = enable;
+    }
+
+    void min_level(int level)
+    {
+        m_min_level = level;
+        rebuild();
+    }
+
+    int min_level() const { return m_min_level; }
+
+    void search(const wxString& text)
+    {
+        // Longer text can be found only in already found messages
+        const bool narrowing = !m_search.empty() && text.find(m_search) != wxString::npos;
+        m_search = text;
+
+        if ( !narrowing )
+        {
+            rebuild();
+            return;
+        }
+
+        std::deque<unsigned long long> shown;
+        for ( std::deque<unsigned long long>::const_iterator iter = m_shown.begin();
+              iter != m_shown.end(); ++iter )
+        {
+            if ( matches(record_at(*iter)) )
+                shown.push_back(*iter);
+        }
+        m_shown.swap(shown);
+        update(true);
+    }
+
+    const wxString& search() const { return m_search; }
+
+    void clear()
+    {
+        m_begin = m_end;
+        m_shown.clear();
+        update(true);
+    }
+
+    size_type size() const { return static_cast<size_type>(m_end - m_begin); }
+
+    size_type shown_count() const { return m_shown.size(); }
+
+protected:
+    virtual wxString OnGetItemText(long item, long column) const wxOVERRIDE
+    {
+        const record& r = shown_record(item);
+        switch ( column )
+        {
+            case time_column:  return wxDateTime(r.time).Format(wxS("%H:%M:%S.%l"));
+            case level_column: return level_name(r.level);
+            default:           return r.text;
+        }
+    }
+
+    virtual wxListItemAttr* OnGetItemAttr(long item) const wxOVERRIDE
+    {
+        const int level = shown_record(item).level;
+        if ( level <= BOOST_UI_LOG_LEVEL_ERROR )
+            return &m_error_attr;
+        if ( level == BOOST_UI_LOG_LEVEL_WARNING )
+            return &m_warning_attr;
+        return NULL;
+    }
+
+private:
+    struct record
+    {
+        record() : level(BOOST_UI_LOG_LEVEL_TRACE) {}
+
+        int level;
+        wxLongLong time;
+        wxString text;
+    };
+
+    const record& record_at(unsigned long long seq) const
+    {
+        return m_records[static_cast<std::size_t>(seq % m_records.size())];
+    }
+
+    const record& shown_record(long item) const
+    {
+        return record_at(m_shown[static_cast<std::size_t>(item)]);
+    }
+
+    bool matches(const record& r) const
+    {
+        return r.level <= m_min_level &&
+               ( m_search.empty() || r.text.find(m_search) != wxString::npos );
+    }
+
+    // Record that is overwritten by the next message
+    record& next_record()
+    {
+        return m_records[static_cast<std::size_t>(m_end % m_records.size())];
+    }
+
+    // Adds message that was written into next_record(), takes constant time,
+    // returns true if the first shown message was removed
+    bool store()
+    {
+        bool removed = false;
+        if ( m_end - m_begin == m_records.size() )
+        {
+            if ( !m_shown.empty() && m_shown.front() == m_begin )
+            {
+                m_shown.pop_front();
+                removed = true;
+            }
+            ++m_begin;
+        }
+
+        if ( matches(next_record()) )
+            m_shown.push_back(m_end);
+        ++m_end;
+
+        return removed;
+    }
+
+    void rebuild()
+    {
+        m_shown.clear();
+        for ( unsigned long long seq = m_begin; seq != m_end; ++seq )
+        {
+            if ( matches(record_at(seq)) )
+                m_shown.push_back(seq);
+        }
+        update(true);
+    }
+
+    // Keeps the last row visible if it was visible before
+    void update(bool shifted)
+    {
+        const long old_count = GetItemCount();
+        const long count = static_cast<long>(m_shown.size());
+        const bool following = GetTopItem() + GetCountPerPage() >= old_count;
+
+        SetItemCount(count);
+
+        if ( shifted )
+            Refresh();
+        else if ( count > old_count )
+            RefreshItems(old_count, count - 1);
+
+        if ( following && count > 0 )
+            EnsureVisible(count - 1);
+    }
+
+    void on_timer(wxTimerEvent&)
+    {
+        const unsigned long long end = m_end;
+        bool shifted = false;
+        while ( m_queue->pop(next_record()) )
+            shifted = store() || shifted;
+
+        const unsigned long long dropped = m_queue->take_dropped();
+        if ( dropped )
+        {
+            record& r = next_record();
+            r.level = BOOST_UI_LOG_LEVEL_WARNING;
+            r.time  = wxGetUTCTimeMillis();
+            r.text.clear();
+            r.text << wxULongLong(dropped).ToString() << wxS(" messages were dropped");
+            shifted = store() || shifted;
+        }
+
+        if ( m_end != end )
+            update(shifted);
+
+        // Timer stays stopped until the next message
+        m_queue->idle();
+    }
+
+    std::vector<record> m_records;
+    unsigned long long m_begin;
+    unsigned long long m_end;
+
+    // Sequence numbers of messages that match filters
+    std::deque<unsigned long long> m_shown;
+
+    int m_min_level;
+    wxString m_search;
+    bool m_capturing;
+
+    wxTimer m_timer;
+    const boost::shared_ptr<message_queue> m_queue;
+
+    mutable wxListItemAttr m_error_attr;
+    mutable wxListItemAttr m_warning_attr;
+};
+
+class log_view::detail_impl : public detail::widget_detail<log_view::native_impl>
+{
+public:
+    explicit detail_impl(widget& parent, size_type capacity)
+    {
+        set_native_handle(new native_impl(parent, capacity));
+    }
+
+    native_impl* view() { return m_native; }
+    const native_impl* view() const { return m_native; }
+};
+
+#endif // wxUSE_LISTCTRL && wxUSE_TIMER
+
+log_view::detail_impl* log_view::get_impl()
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    return get_detail_impl<detail_impl>();
+#else
+    return NULL;
+#endif
+}
+
+const log_view::detail_impl* log_view::get_impl() const
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    return get_detail_impl<detail_impl>();
+#else
+    return NULL;
+#endif
+}
+
+log_view& log_view::create(widget& parent, size_type capacity)
+{
+    wxCHECK_MSG(capacity > 0, *this, "Capacity should be positive");
+
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    detail_set_detail_impl(new detail_impl(parent, capacity));
+#endif
+
+    return *this;
+}
+
+log_view& log_view::append(int level, const uistring& text)
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, *this, "Widget should be created");
+
+    impl->view()->write(level, text);
+#endif
+
+    return *this;
+}
+
+log_view& log_view::capture(bool enable)
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, *this, "Widget should be created");
+
+    impl->view()->capture(enable);
+#endif
+
+    return *this;
+}
+
+log_view& log_view::min_level(int level)
+{
+    wxCHECK_MSG(level >= BOOST_UI_LOG_LEVEL_FATAL && level <= BOOST_UI_LOG_LEVEL_TRACE,
+                *this, "Invalid log level");
+
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, *this, "Widget should be created");
+
+    impl->view()->min_level(level);
+#endif
+
+    return *this;
+}
+
+int log_view::min_level() const
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    const detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, BOOST_UI_LOG_LEVEL_TRACE, "Widget should be created");
+
+    return impl->view()->min_level();
+#else
+    return BOOST_UI_LOG_LEVEL_TRACE;
+#endif
+}
+
+log_view& log_view::search(const uistring& text)
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, *this, "Widget should be created");
+
+    impl->view()->search(native::from_uistring(text));
+#endif
+
+    return *this;
+}
+
+uistring log_view::search() const
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    const detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, uistring(), "Widget should be created");
+
+    return native::to_uistring(impl->view()->search());
+#else
+    return uistring();
+#endif
+}
+
+void log_view::clear()
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    detail_impl* impl = get_impl();
+    wxCHECK_RET(impl, "Widget should be created");
+
+    impl->view()->clear();
+#endif
+}
+
+log_view::size_type log_view::size() const
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    const detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, 0, "Widget should be created");
+
+    return impl->view()->size();
+#else
+    return 0;
+#endif
+}
+
+log_view::size_type log_view::shown_count() const
+{
+#if wxUSE_LISTCTRL && wxUSE_TIMER
+    const detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, 0, "Widget should be created");
+
+    return impl->view()->shown_count();
+#else
+    return 0;
+#endif
+}
+
+} // namespace ui
+} // namespace boost
@@ -8,11 +8,20 @@
 #include <boost/ui/native/config.hpp>
 
 #include <boost/ui/progress_bar.hpp>
+#include <boost/ui/application.hpp>
+#include <boost/ui/thread.hpp>
+#include <boost/ui/native/event.hpp>
 #include <boost/ui/native/widget.hpp>
 #include <boost/ui/detail/memcheck.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/throw_exception.hpp>
 
+#include <algorithm>
+
 #include <wx/gauge.h>
 
 namespace boost {
@@ -124,5 +133,121 @@ void progress_bar::check_range(value_type value, value_type max)
         BOOST_THROW_EXCEPTION(std::out_of_range("ui::progress_bar::check_range(): invalid value"));
 }
 
+#if wxUSE_GAUGE
+
+namespace {
+
+// Minimal interval between updates of the progress bar
+const int frame_ms = 16;
+
+} // unnamed namespace
+
+// Only one update is queued at a time, it applies the latest reported value.
+// Native gauge is accessed from the UI thread only until the token is cancelled.
+// Isn't checked by detail::memcheck because it is released from any thread
+class progress_reporter::impl : public boost::enable_shared_from_this<impl>,
+                                private detail::async_item
+{
+public:
+    explicit impl(progress_bar& bar)
+        : m_gauge(native::from_widget<wxGauge>(bar)), m_token(bar),
+          m_value(0), m_queued(false), m_last_update(0)
+    {
+        call = &impl::on_queued;
+        next = NULL;
+    }
+
+    void report(progress_bar::value_type value)
+    {
+        m_value.store(value, boost::memory_order_relaxed);
+        if ( m_queued.exchange(true, boost::memory_order_acq_rel) )
+            return;
+
+        // Isn't accessed by the UI thread until the next update
+        m_self = shared_from_this();
+        detail::call_async(static_cast<detail::async_item*>(this));
+    }
+
+    const cancellation_token& token() const
+    {
+        return m_token;
+    }
+
+private:
+    static void on_queued(detail::async_item* item)
+    {
+        impl* p = static_cast<impl*>(item);
+
+        boost::shared_ptr<impl> self;
+        self.swap(p->m_self);
+
+        // Milliseconds of monotonic clock, so system time changes don't stop updates
+        const boost::uint64_t elapsed = (native::event_trace_now() - p->m_last_update) / 1000;
+        if ( elapsed >= frame_ms )
+            p->update();
+        else
+            detail::on_timeout(frame_ms - static_cast<int>(elapsed),
+                               boost::bind(&impl::update, self));
+    }
+
+    void update()
+    {
+        // Synchronizes with the report that stored the latest value
+        m_queued.exchange(false, boost::memory_order_acq_rel);
+        const progress_bar::value_type value = m_value.load(boost::memory_order_relaxed);
+
+        if ( !m_gauge || m_token.cancelled() )
+            return;
+
+        m_last_update = native::event_trace_now();
+        m_gauge->SetValue((std::max)(0, (std::min)(value, m_gauge->GetRange())));
+    }
+
+    wxGauge* const m_gauge;
+    const cancellation_token m_token;
+
+    boost::atomic<progress_bar::value_type> m_value;
+    boost::atomic<bool> m_queued;
+    boost::uint64_t m_last_update;
+
+    // Keeps queued update valid after all reporters are destroyed
+    boost::shared_ptr<impl> m_self;
+};
+
+#else // !wxUSE_GAUGE
+
+class progress_reporter::impl
+{
+public:
+    explicit impl(progress_bar& bar) : m_token(bar) {}
+
+    void report(progress_bar::value_type) {}
+
+    const cancellation_token& token() const
+    {
+        return m_token;
+    }
+
+private:
+    const cancellation_token m_token;
+};
+
+#endif // wxUSE_GAUGE
+
+progress_reporter::progress_reporter(progress_bar& bar)
+    : m_impl(boost::make_shared<impl>(boost::ref(bar)))
+{
+}
+
+void progress_reporter::report(progress_bar::value_type value) const
+{
+    m_impl->report(value);
+}
+
+cancellation_token progress_reporter::token() const
+{
+    return m_impl->token();
+}
+
 } // namespace ui
 } // namespace boost
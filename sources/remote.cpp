@@ -0,0 +1,142 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/remote.hpp>
+#include <boost/ui/cancellation.hpp>
+#include <boost/ui/executor.hpp>
+#include <boost/ui/thread.hpp>
+#include <boost/ui/detail/memcheck.hpp>
+
+#include <boost/enable_shared_from_this.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <wx/thread.h>
+
+namespace boost  {
+namespace ui     {
+namespace detail {
+
+namespace {
+
+// Addresses are keys of the predefined properties
+const char property_keys[remote_base::property_count] = {};
+
+} // unnamed namespace
+
+// Changes are recorded under the mutex, only one batch is queued at a time.
+// Widget copy is used and released in the UI thread only
+class remote_base::impl : public boost::enable_shared_from_this<impl>,
+                          private async_item, private memcheck
+{
+public:
+    explicit impl(widget* w) : m_widget(w), m_token(*w), m_queued(false)
+    {
+        call = &impl::on_queued;
+        next = NULL;
+    }
+
+    ~impl()
+    {
+        delete m_widget;
+    }
+
+    void set(const void* key, const boost::function<void(widget&)>& fn)
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+
+            for ( std::size_t i = 0; i < m_changes.size(); i++ )
+            {
+                if ( m_changes[i].first == key )
+                {
+                    m_changes[i].second = fn;
+                    return;
+                }
+            }
+            m_changes.push_back(std::make_pair(key, fn));
+
+            if ( m_queued )
+                return;
+
+            m_queued = true;
+            m_self = shared_from_this();
+        }
+
+        call_async(static_cast<async_item*>(this));
+    }
+
+    // Deleter of the shared pointer, last copy can be released in any thread
+    static void release(impl* p)
+    {
+        if ( is_ui_thread() )
+            delete p;
+        else
+            call_async(boost::bind(&impl::destroy, p));
+    }
+
+private:
+    typedef std::vector< std::pair< const void*, boost::function<void(widget&)> > > changes_type;
+
+    static void destroy(impl* p)
+    {
+        delete p;
+    }
+
+    static void on_queued(async_item* item)
+    {
+        impl* p = static_cast<impl*>(item);
+
+        boost::shared_ptr<impl> self;
+        changes_type changes;
+        {
+            wxMutexLocker lock(p->m_mutex);
+            self.swap(p->m_self);
+            changes.swap(p->m_changes);
+            p->m_queued = false;
+        }
+
+        if ( p->m_token.cancelled() || !p->m_widget->native_valid() )
+            return;
+
+        for ( std::size_t i = 0; i < changes.size(); i++ )
+            changes[i].second(*p->m_widget);
+    }
+
+    widget* const m_widget;
+    const cancellation_token m_token;
+
+    wxMutex m_mutex;
+    changes_type m_changes;
+    bool m_queued;
+
+    // Keeps queued batch valid after all proxies are released
+    boost::shared_ptr<impl> m_self;
+};
+
+remote_base::remote_base(widget* w)
+    : m_impl(new impl(w), &impl::release)
+{
+}
+
+void remote_base::set_raw(property p, const boost::function<void(widget&)>& fn)
+{
+    wxCHECK_RET(p >= 0 && p < property_count, "Invalid property");
+    m_impl->set(&property_keys[p], fn);
+}
+
+void remote_base::set_raw(const void* key, const boost::function<void(widget&)>& fn)
+{
+    m_impl->set(key, fn);
+}
+
+} // namespace detail
+} // namespace ui
+} // namespace boost
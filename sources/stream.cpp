@@ -8,22 +8,77 @@
 #include <boost/ui/native/config.hpp>
 
 #include <boost/ui/stream.hpp>
-#include <boost/ui/native/string.hpp>
-
-#include <wx/string.h>
 
 namespace boost {
 namespace ui    {
 
+namespace detail {
+
+namespace {
+
+void append_text(uistring& str, const char* first, const char* last)
+{
+    str.append_ascii(first, last - first);
+}
+
+void append_text(uistring& str, const wchar_t* first, const wchar_t* last)
+{
+    str.append(first, last - first);
+}
+
+template <class CharT>
+const CharT* append_format_text_detail(uistring& str, const CharT* fmt)
+{
+    const CharT* begin = fmt;
+    for ( ;; ++fmt )
+    {
+        if ( *fmt == CharT(0) )
+        {
+            append_text(str, begin, fmt);
+            return NULL;
+        }
+        else if ( *fmt == CharT('{') && fmt[1] == CharT('}') )
+        {
+            append_text(str, begin, fmt);
+            return fmt + 2;
+        }
+        else if ( ( *fmt == CharT('{') || *fmt == CharT('}') ) && fmt[1] == *fmt )
+        {
+            append_text(str, begin, fmt + 1);
+            begin = ++fmt + 1;
+        }
+    }
+}
+
+} // unnamed namespace
+
+const char* append_format_text(uistring& str, const char* fmt)
+{
+    return append_format_text_detail(str, fmt);
+}
+
+const wchar_t* append_format_text(uistring& str, const wchar_t* fmt)
+{
+    return append_format_text_detail(str, fmt);
+}
+
+} // namespace detail
+
 uiostringstream& uiostringstream::operator<<(float value)
 {
-    m_buffer += native::to_uistring(wxString() << value);
+    detail::append_floating(m_buffer, value, m_format, m_precision);
     return *this;
 }
 
 uiostringstream& uiostringstream::operator<<(double value)
 {
-    m_buffer += native::to_uistring(wxString() << value);
+    detail::append_floating(m_buffer, value, m_format, m_precision);
+    return *this;
+}
+
+uiostringstream& uiostringstream::operator<<(long double value)
+{
+    detail::append_floating(m_buffer, value, m_format, m_precision);
     return *this;
 }
 
@@ -11,14 +11,13 @@
 #include <boost/ui/string_io.hpp>
 #include <boost/ui/native/string.hpp>
 #include <boost/ui/detail/memcheck.hpp>
+#include <boost/ui/detail/to_chars.hpp>
 
 #include <boost/functional/hash.hpp>
 
 #include <wx/string.h>
 #include <wx/log.h>
 
-#include <stdio.h> // for snprintf()
-
 namespace boost {
 namespace ui    {
 
@@ -109,6 +108,28 @@ uistring& uistring::append(size_type count, wchar_t ch)
     return *this;
 }
 
+uistring& uistring::append(const wchar_t* str, size_type count)
+{
+    m_impl->append(str, count);
+    return *this;
+}
+
+uistring& uistring::append_ascii(const char* str, size_type count)
+{
+    wchar_t buffer[64];
+    while ( count > 0 )
+    {
+        const size_type chunk = count < 64 ? count : 64;
+        for ( size_type i = 0; i < chunk; ++i )
+            buffer[i] = static_cast<unsigned char>(str[i]);
+
+        m_impl->append(buffer, chunk);
+        str += chunk;
+        count -= chunk;
+    }
+    return *this;
+}
+
 #ifndef BOOST_UI_NO_CAST_FROM_ASCII
 
 void uistring::push_back(char ch)
@@ -143,6 +164,11 @@ void uistring::clear() BOOST_NOEXCEPT
     m_impl->clear();
 }
 
+void uistring::reserve(size_type new_cap)
+{
+    m_impl->reserve(new_cap);
+}
+
 void uistring::shrink_to_fit()
 {
     m_impl->Shrink();
@@ -189,63 +215,81 @@ std::wstring uistring::wstring() const
 namespace {
 
 template <class T>
-uistring to_uistring_detail(T value, const char* format)
+uistring to_uistring_integer(T value)
 {
-    char buffer[32];
-#ifdef _MSC_VER
-    _snprintf
-#else
-    snprintf
-#endif
-        (buffer, sizeof buffer / sizeof buffer[0], format, value);
-    return ascii(buffer);
+    uistring result;
+    detail::append_integer(result, value);
+    return result;
+}
+
+template <class T>
+uistring to_uistring_floating(T value, chars_format fmt, int precision)
+{
+    uistring result;
+    detail::append_floating(result, value, fmt, precision);
+    return result;
 }
 
 } // unnamed namespace
 
 uistring to_uistring(int value)
 {
-    return to_uistring_detail(value, "%d");
+    return to_uistring_integer(value);
 }
 
 uistring to_uistring(unsigned int value)
 {
-    return to_uistring_detail(value, "%u");
+    return to_uistring_integer(value);
 }
 
 uistring to_uistring(long value)
 {
-    return to_uistring_detail(value, "%ld");
+    return to_uistring_integer(value);
 }
 
 uistring to_uistring(unsigned long value)
 {
-    return to_uistring_detail(value, "%lu");
+    return to_uistring_integer(value);
 }
 
 uistring to_uistring(long long value)
 {
-    return to_uistring_detail(value, "%lld");
+    return to_uistring_integer(value);
 }
 
 uistring to_uistring(unsigned long long value)
 {
-    return to_uistring_detail(value, "%llu");
+    return to_uistring_integer(value);
 }
 
 uistring to_uistring(float value)
 {
-    return to_uistring_detail(value, "%f");
+    return to_uistring_floating(value, chars_format::general, -1);
 }
 
 uistring to_uistring(double value)
 {
-    return to_uistring_detail(value, "%f");
+    return to_uistring_floating(value, chars_format::general, -1);
 }
 
 uistring to_uistring(long double value)
 {
-    return to_uistring_detail(value, "%Lf");
+    return to_uistring_floating(value, chars_format::general, -1);
+}
+
+uistring to_uistring(float value, chars_format fmt, int precision)
+{
+    return to_uistring_floating(value, fmt, precision);
+}
+
+uistring to_uistring(double value, chars_format fmt, int precision)
+{
+    return to_uistring_floating(value, fmt, precision);
+}
+
+uistring to_uistring(long double value, chars_format fmt, int precision)
+{
+    return to_uistring_floating(value, fmt, precision);
 }
 
 std::size_t hash_value(const uistring& value)
@@ -261,6 +305,11 @@ public:
         return *str.m_impl;
     }
 
+    static const wxString& from_uistring_ref(const uistring& str)
+    {
+        return *str.m_impl;
+    }
+
     static uistring to_uistring(const wxString& str)
     {
         uistring result;
@@ -276,6 +325,11 @@ wxString from_uistring(const uistring& str)
     return native_helper::from_uistring(str);
 }
 
+const wxString& from_uistring_ref(const uistring& str)
+{
+    return native_helper::from_uistring_ref(str);
+}
+
 uistring to_uistring(const wxString& str)
 {
     return native_helper::to_uistring(str);
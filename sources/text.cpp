@@ -0,0 +1,304 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/text.hpp>
+
+#include <boost/make_shared.hpp>
+#include <boost/assert.hpp>
+
+#include <cwchar>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace ui    {
+
+// Immutable rope node: either leaf with characters or concatenation of two nodes
+class uitext::node
+{
+public:
+    explicit node(const std::wstring& text)
+        : m_text(text), m_size(text.size()), m_height(0) {}
+
+    node(const node_ptr& left, const node_ptr& right)
+        : m_left(left), m_right(right),
+          m_size(left->m_size + right->m_size),
+          m_height(1 + (left->m_height > right->m_height ?
+                        left->m_height : right->m_height)) {}
+
+    bool is_leaf() const { return !m_left; }
+
+    const node_ptr m_left;
+    const node_ptr m_right;
+    const std::wstring m_text;
+    const size_type m_size;
+    const int m_height;
+};
+
+namespace {
+
+// Maximal count of characters in a leaf that is built by small appends
+const std::size_t max_leaf_size = 1024;
+
+} // unnamed namespace
+
+#ifndef DOXYGEN
+
+// Join-based AVL tree algorithms
+class uitext_detail
+{
+    typedef uitext::node node;
+    typedef uitext::node_ptr node_ptr;
+    typedef uitext::size_type size_type;
+
+public:
+    static int height(const node_ptr& n)
+    {
+        return n ? n->m_height : -1;
+    }
+
+    static node_ptr make_leaf(const wchar_t* str, size_type count)
+    {
+        if ( count == 0 )
+            return node_ptr();
+
+        if ( count <= max_leaf_size )
+            return boost::make_shared<node>(std::wstring(str, count));
+
+        // Build balanced tree from leaves for long strings
+        const size_type half = count / 2;
+        return make_concat(make_leaf(str, half),
+                           make_leaf(str + half, count - half));
+    }
+
+    static node_ptr make_concat(const node_ptr& left, const node_ptr& right)
+    {
+        return boost::make_shared<node>(left, right);
+    }
+
+    static node_ptr rotate_left(const node_ptr& n)
+    {
+        const node_ptr& r = n->m_right;
+        return make_concat(make_concat(n->m_left, r->m_left), r->m_right);
+    }
+
+    static node_ptr rotate_right(const node_ptr& n)
+    {
+        const node_ptr& l = n->m_left;
+        return make_concat(l->m_left, make_concat(l->m_right, n->m_right));
+    }
+
+    static node_ptr balance(const node_ptr& left, const node_ptr& right)
+    {
+        if ( height(left) > height(right) + 1 )
+        {
+            node_ptr l = left;
+            if ( height(l->m_right) > height(l->m_left) )
+                l = rotate_left(l);
+            return rotate_right(make_concat(l, right));
+        }
+        if ( height(right) > height(left) + 1 )
+        {
+            node_ptr r = right;
+            if ( height(r->m_left) > height(r->m_right) )
+                r = rotate_right(r);
+            return rotate_left(make_concat(left, r));
+        }
+        return make_concat(left, right);
+    }
+
+    static node_ptr join(const node_ptr& left, const node_ptr& right)
+    {
+        if ( !left )
+            return right;
+        if ( !right )
+            return left;
+
+        // Merge small neighbour leaves to avoid tiny chunks
+        if ( left->is_leaf() && right->is_leaf() &&
+             left->m_size + right->m_size <= max_leaf_size )
+            return boost::make_shared<node>(left->m_text + right->m_text);
+
+        if ( height(left) > height(right) + 1 )
+            return balance(left->m_left, join(left->m_right, right));
+        if ( height(right) > height(left) + 1 )
+            return balance(join(left, right->m_left), right->m_right);
+
+        return make_concat(left, right);
+    }
+
+    static std::pair<node_ptr, node_ptr> split(const node_ptr& n, size_type pos)
+    {
+        if ( !n || pos == 0 )
+            return std::make_pair(node_ptr(), n);
+        if ( pos >= n->m_size )
+            return std::make_pair(n, node_ptr());
+
+        if ( n->is_leaf() )
+            return std::make_pair(
+                make_leaf(n->m_text.data(), pos),
+                make_leaf(n->m_text.data() + pos, n->m_size - pos));
+
+        const size_type left_size = n->m_left->m_size;
+        if ( pos == left_size )
+            return std::make_pair(n->m_left, n->m_right);
+
+        if ( pos < left_size )
+        {
+            const std::pair<node_ptr, node_ptr> parts = split(n->m_left, pos);
+            return std::make_pair(parts.first, join(parts.second, n->m_right));
+        }
+
+        const std::pair<node_ptr, node_ptr> parts =
+            split(n->m_right, pos - left_size);
+        return std::make_pair(join(n->m_left, parts.first), parts.second);
+    }
+
+    static void for_each_chunk(const node_ptr& n,
+        const boost::function<void(const wchar_t*, size_type)>& fn)
+    {
+        if ( !n )
+            return;
+
+        if ( n->is_leaf() )
+        {
+            fn(n->m_text.data(), n->m_size);
+            return;
+        }
+
+        for_each_chunk(n->m_left, fn);
+        for_each_chunk(n->m_right, fn);
+    }
+
+    static void append_to(const node_ptr& n, uistring& str)
+    {
+        if ( !n )
+            return;
+
+        if ( n->is_leaf() )
+        {
+            str.append(n->m_text.data(), n->m_size);
+            return;
+        }
+
+        append_to(n->m_left, str);
+        append_to(n->m_right, str);
+    }
+};
+
+#endif
+
+uitext::uitext(const uistring& str)
+{
+    const std::wstring wstr = str.wstring();
+    m_root = uitext_detail::make_leaf(wstr.data(), wstr.size());
+}
+
+uitext::uitext(const wchar_t* str)
+{
+    m_root = uitext_detail::make_leaf(str, std::wcslen(str));
+}
+
+uitext::size_type uitext::size() const BOOST_NOEXCEPT
+{
+    return m_root ? m_root->m_size : 0;
+}
+
+wchar_t uitext::operator[](size_type pos) const
+{
+    BOOST_ASSERT_MSG(pos < size(), "Position is out of range");
+
+    const node* n = m_root.get();
+    while ( !n->is_leaf() )
+    {
+        const size_type left_size = n->m_left->m_size;
+        if ( pos < left_size )
+            n = n->m_left.get();
+        else
+        {
+            pos -= left_size;
+            n = n->m_right.get();
+        }
+    }
+    return n->m_text[pos];
+}
+
+uitext& uitext::append(const uistring& str)
+{
+    const std::wstring wstr = str.wstring();
+    return append(wstr.data(), wstr.size());
+}
+
+uitext& uitext::append(const wchar_t* str, size_type count)
+{
+    m_root = uitext_detail::join(m_root, uitext_detail::make_leaf(str, count));
+    return *this;
+}
+
+uitext& uitext::append(const uitext& other)
+{
+    m_root = uitext_detail::join(m_root, other.m_root);
+    return *this;
+}
+
+uitext& uitext::insert(size_type pos, const uistring& str)
+{
+    return insert(pos, uitext(str));
+}
+
+uitext& uitext::insert(size_type pos, const uitext& other)
+{
+    BOOST_ASSERT_MSG(pos <= size(), "Position is out of range");
+
+    const std::pair<node_ptr, node_ptr> parts = uitext_detail::split(m_root, pos);
+    m_root = uitext_detail::join(uitext_detail::join(parts.first, other.m_root),
+                                 parts.second);
+    return *this;
+}
+
+uitext& uitext::erase(size_type pos, size_type count)
+{
+    BOOST_ASSERT_MSG(pos <= size(), "Position is out of range");
+
+    const std::pair<node_ptr, node_ptr> head = uitext_detail::split(m_root, pos);
+    if ( count >= size() - pos )
+    {
+        m_root = head.first;
+        return *this;
+    }
+
+    const std::pair<node_ptr, node_ptr> tail =
+        uitext_detail::split(head.second, count);
+    m_root = uitext_detail::join(head.first, tail.second);
+    return *this;
+}
+
+uitext uitext::substr(size_type pos, size_type count) const
+{
+    BOOST_ASSERT_MSG(pos <= size(), "Position is out of range");
+
+    const node_ptr tail = uitext_detail::split(m_root, pos).second;
+    return uitext(uitext_detail::split(tail, count).first);
+}
+
+uistring uitext::str() const
+{
+    uistring result;
+    result.reserve(size());
+    uitext_detail::append_to(m_root, result);
+    return result;
+}
+
+void uitext::for_each_chunk(const boost::function<void(const wchar_t*, size_type)>& fn) const
+{
+    uitext_detail::for_each_chunk(m_root, fn);
+}
+
+} // namespace ui
+} // namespace boost
@@ -13,6 +13,8 @@
 #include <boost/ui/native/widget.hpp>
 #include <boost/ui/detail/memcheck.hpp>
 
+#include <boost/bind.hpp>
+
 #include <wx/textctrl.h>
 
 namespace boost {
@@ -39,11 +41,40 @@ public:
         wxCHECK_RET(m_native, "Widget should be created");
         m_native->ChangeValue(native::from_uistring(text));
     }
+    void text(const uitext& text)
+    {
+        wxCHECK_RET(m_native, "Widget should be created");
+        m_native->ChangeValue(to_native(text));
+    }
+    void append_text(const uistring& text)
+    {
+        wxCHECK_RET(m_native, "Widget should be created");
+        m_native->AppendText(native::from_uistring(text));
+    }
+    void append_text(const uitext& text)
+    {
+        wxCHECK_RET(m_native, "Widget should be created");
+        m_native->AppendText(to_native(text));
+    }
     uistring text() const
     {
         wxCHECK_MSG(m_native, uistring(), "Widget should be created");
         return native::to_uistring(m_native->GetValue());
     }
+
+private:
+    static wxString to_native(const uitext& text)
+    {
+        wxString value;
+        value.reserve(text.size());
+        text.for_each_chunk(boost::bind(&detail_impl::append_chunk,
+                                        boost::ref(value), _1, _2));
+        return value;
+    }
+    static void append_chunk(wxString& value, const wchar_t* data, std::size_t size)
+    {
+        value.append(data, size);
+    }
 };
 
 #endif
@@ -95,6 +126,42 @@ text_box_base& text_box_base::text(const uistring& text)
     return *this;
 }
 
+text_box_base& text_box_base::text(const uitext& text)
+{
+#if wxUSE_TEXTCTRL
+    detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, *this, "Widget should be created");
+
+    impl->text(text);
+#endif
+
+    return *this;
+}
+
+text_box_base& text_box_base::append_text(const uistring& text)
+{
+#if wxUSE_TEXTCTRL
+    detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, *this, "Widget should be created");
+
+    impl->append_text(text);
+#endif
+
+    return *this;
+}
+
+text_box_base& text_box_base::append_text(const uitext& text)
+{
+#if wxUSE_TEXTCTRL
+    detail_impl* impl = get_impl();
+    wxCHECK_MSG(impl, *this, "Widget should be created");
+
+    impl->append_text(text);
+#endif
+
+    return *this;
+}
+
 uistring text_box_base::text() const
 {
 #if wxUSE_TEXTCTRL
@@ -8,28 +8,255 @@
 #include <boost/ui/native/config.hpp>
 
 #include <boost/ui/thread.hpp>
+#include <boost/ui/native/event.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <map>
 
 #include <wx/app.h>
+#include <wx/thread.h>
 
 namespace boost  {
 namespace ui     {
-namespace detail {
 
-void call_async(const boost::function<void()>& fn)
+namespace {
+
+// Records time that function spent in the queue
+class traced_function
+{
+public:
+    explicit traced_function(const boost::function<void()>& fn)
+        : m_fn(fn), m_enqueued(native::event_trace_now()) {}
+
+    void operator()() const
+    {
+        static const char key = 0;
+        native::event_trace_scope scope(&key, "call_async", m_enqueued);
+        m_fn();
+    }
+
+private:
+    boost::function<void()> m_fn;
+    boost::uint64_t m_enqueued;
+};
+
+// Item that owns function passed to call_async()
+struct function_item : detail::async_item
+{
+    explicit function_item(const boost::function<void()>& f) : fn(f)
+    {
+        call = &function_item::invoke;
+        next = NULL;
+    }
+
+    static void invoke(detail::async_item* item)
+    {
+        boost::function<void()> fn;
+        fn.swap(static_cast<function_item*>(item)->fn);
+        delete static_cast<function_item*>(item);
+        fn();
+    }
+
+    boost::function<void()> fn;
+};
+
+// Lock-free stack of functions pushed by many threads,
+// it is reversed when the UI thread takes all functions
+class async_queue : private boost::noncopyable
+{
+public:
+    async_queue() : m_head(NULL) {}
+
+    // Returns true if queue was empty, so UI thread should be woken up
+    bool push(detail::async_item* node)
+    {
+        detail::async_item* head = m_head.load(boost::memory_order_relaxed);
+        do
+        {
+            node->next = head;
+        }
+        while ( !m_head.compare_exchange_weak(head, node,
+                                              boost::memory_order_release,
+                                              boost::memory_order_relaxed) );
+        return head == NULL;
+    }
+
+    detail::async_item* take_all()
+    {
+        detail::async_item* node = m_head.exchange(NULL, boost::memory_order_acquire);
+
+        detail::async_item* reversed = NULL;
+        while ( node )
+        {
+            detail::async_item* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        return reversed;
+    }
+
+private:
+    boost::atomic<detail::async_item*> m_head;
+};
+
+async_queue g_queue;
+boost::atomic<std::size_t> g_depth(0);
+boost::atomic<std::size_t> g_max_depth(0);
+boost::atomic<boost::uint64_t> g_calls(0);
+boost::atomic<boost::uint64_t> g_batches(0);
+boost::atomic<boost::uint64_t> g_superseded(0);
+
+// Accessed from the UI thread only
+detail::async_item* g_pending = NULL;
+latency_histogram g_drain_time;
+
+void drain_async_queue();
+
+void wake_up()
 {
 #ifdef wxHAS_CALL_AFTER
     wxAppConsole* app = wxApp::GetInstance();
     if ( app )
     {
-        app->CallAfter(fn);
+        app->CallAfter(&drain_async_queue);
         return;
     }
 #endif
 
     wxFAIL;
+    drain_async_queue();
+}
+
+// Keeps functions that weren't called because of exception for the next batch
+class drain_guard : private boost::noncopyable
+{
+public:
+    ~drain_guard()
+    {
+        if ( g_pending )
+            wake_up();
+    }
+};
+
+// Calls all queued functions in one wakeup of the UI thread.
+// Function can run nested event loop that drains the rest of batch,
+// so the next node is always taken from g_pending.
+void drain_async_queue()
+{
+    const boost::uint64_t begin = native::event_trace_now();
+    drain_guard guard;
+
+    detail::async_item* taken = g_queue.take_all();
+    if ( g_pending )
+    {
+        detail::async_item* tail = g_pending;
+        while ( tail->next )
+            tail = tail->next;
+        tail->next = taken;
+    }
+    else
+        g_pending = taken;
+
+    if ( !g_pending )
+        return;
+
+    while ( g_pending )
+    {
+        detail::async_item* item = g_pending;
+        g_pending = item->next;
+        g_depth.fetch_sub(1, boost::memory_order_relaxed);
+
+        g_calls.fetch_add(1, boost::memory_order_relaxed);
+        item->call(item);
+    }
+
+    g_batches.fetch_add(1, boost::memory_order_relaxed);
+    g_drain_time.record(native::event_trace_now() - begin);
+}
+
+// The latest functions of call_async_latest() that are queued
+// but not called yet, one per key
+typedef std::map< const void*, boost::function<void()> > latest_map;
+latest_map g_latest;
+wxMutex g_latest_mutex;
+
+void call_latest(const void* key)
+{
+    boost::function<void()> fn;
+    {
+        wxMutexLocker lock(g_latest_mutex);
+        latest_map::iterator iter = g_latest.find(key);
+        wxCHECK_RET(iter != g_latest.end(), "Function should be queued");
+        fn.swap(iter->second);
+        g_latest.erase(iter);
+    }
+
     fn();
 }
 
+} // unnamed namespace
+
+namespace detail {
+
+void call_async(async_item* item)
+{
+    const std::size_t depth = g_depth.fetch_add(1, boost::memory_order_relaxed) + 1;
+    std::size_t max_depth = g_max_depth.load(boost::memory_order_relaxed);
+    while ( depth > max_depth &&
+            !g_max_depth.compare_exchange_weak(max_depth, depth,
+                                               boost::memory_order_relaxed) )
+    {
+    }
+
+    if ( g_queue.push(item) )
+        wake_up();
+}
+
+void call_async(const boost::function<void()>& fn)
+{
+    call_async(native::event_trace_running() ?
+        new function_item(traced_function(fn)) : new function_item(fn));
+}
+
+void call_async_latest(const void* key, const boost::function<void()>& fn)
+{
+    {
+        wxMutexLocker lock(g_latest_mutex);
+        std::pair<latest_map::iterator, bool> result =
+            g_latest.insert(std::make_pair(key, fn));
+        if ( !result.second )
+        {
+            result.first->second = fn;
+            g_superseded.fetch_add(1, boost::memory_order_relaxed);
+            return;
+        }
+    }
+
+    call_async(boost::bind(&call_latest, key));
+}
+
 } // namespace detail
+
+async_queue_stats async_stats()
+{
+    async_queue_stats stats;
+    stats.depth      = g_depth.load(boost::memory_order_relaxed);
+    stats.max_depth  = g_max_depth.load(boost::memory_order_relaxed);
+    stats.calls      = g_calls.load(boost::memory_order_relaxed);
+    stats.batches    = g_batches.load(boost::memory_order_relaxed);
+    stats.superseded = g_superseded.load(boost::memory_order_relaxed);
+    stats.drain_time = g_drain_time;
+    return stats;
+}
+
+std::size_t async_queue_depth()
+{
+    return g_depth.load(boost::memory_order_relaxed);
+}
+
 } // namespace ui
 } // namespace boost
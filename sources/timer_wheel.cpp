@@ -0,0 +1,277 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/detail/timer_wheel.hpp>
+
+#include <boost/integer_traits.hpp>
+
+namespace boost  {
+namespace ui     {
+namespace detail {
+
+namespace {
+
+const int slot_bits = 6;
+const boost::uint32_t slots_count = 1u << slot_bits;
+const boost::uint32_t slot_mask = slots_count - 1;
+const int levels_count = 4;
+
+// The first nodes are heads of circular lists
+const boost::uint32_t overflow_list = levels_count * slots_count;
+const boost::uint32_t due_list = overflow_list + 1;
+const boost::uint32_t lists_count = due_list + 1;
+const boost::uint32_t no_list = boost::integer_traits<boost::uint32_t>::const_max;
+
+int level_shift(int level)
+{
+    return level * slot_bits;
+}
+
+// Returns index of the lowest set bit, value shouldn't be zero
+int lowest_bit(boost::uint64_t value)
+{
+    int bit = 0;
+    while ( !(value & 1) )
+    {
+        value >>= 1;
+        bit++;
+    }
+    return bit;
+}
+
+} // unnamed namespace
+
+timer_wheel::timer_wheel(boost::uint64_t now)
+    : m_nodes(lists_count), m_free(0), m_count(0), m_now(now)
+{
+    for ( index_type i = 0; i < lists_count; i++ )
+    {
+        m_nodes[i].prev = m_nodes[i].next = i;
+        m_nodes[i].list = i;
+        m_nodes[i].generation = 0;
+        m_nodes[i].expiry = 0;
+    }
+
+    for ( int level = 0; level < levels_count; level++ )
+        m_occupied[level] = 0;
+}
+
+timer_wheel::id_type timer_wheel::schedule(boost::uint64_t expiry,
+                                           const boost::function<void()>& fn)
+{
+    index_type index;
+    if ( m_free )
+    {
+        index = m_free;
+        m_free = m_nodes[index].next;
+    }
+    else
+    {
+        index = static_cast<index_type>(m_nodes.size());
+        m_nodes.push_back(node());
+        m_nodes[index].generation = 0;
+    }
+
+    node& n = m_nodes[index];
+    n.generation++;
+    n.expiry = expiry > m_now ? expiry : m_now + 1;
+    n.fn = fn;
+    insert(index);
+    m_count++;
+
+    return (static_cast<id_type>(n.generation) << 32) | index;
+}
+
+bool timer_wheel::cancel(id_type id)
+{
+    if ( !pending(id) )
+        return false;
+
+    const index_type index = static_cast<index_type>(id);
+    unlink(index);
+    m_nodes[index].fn.clear();
+    release(index);
+    return true;
+}
+
+bool timer_wheel::pending(id_type id) const
+{
+    const index_type index = static_cast<index_type>(id);
+    return index >= lists_count && index < m_nodes.size() &&
+           m_nodes[index].list != no_list &&
+           m_nodes[index].generation == static_cast<boost::uint32_t>(id >> 32);
+}
+
+void timer_wheel::advance(boost::uint64_t now)
+{
+    // Functions that were left because of exception
+    fire_due();
+
+    while ( m_now < now )
+    {
+        // Skips ticks without timers and cascades
+        const boost::uint64_t next = next_expiry();
+        if ( next > now )
+        {
+            m_now = now;
+            break;
+        }
+
+        m_now = next - 1;
+        tick();
+    }
+}
+
+boost::uint64_t timer_wheel::next_expiry() const
+{
+    if ( m_count == 0 )
+        return boost::integer_traits<boost::uint64_t>::const_max;
+
+    if ( m_nodes[due_list].next != due_list )
+        return m_now;
+
+    // Slots after the current one in each level are cascaded or fired
+    // when their range starts
+    for ( int level = 0; level < levels_count; level++ )
+    {
+        const int shift = level_shift(level);
+        const boost::uint32_t current = (m_now >> shift) & slot_mask;
+        const boost::uint64_t later = current == slot_mask ? 0 :
+            m_occupied[level] & (~boost::uint64_t(0) << (current + 1));
+        if ( later )
+        {
+            const boost::uint64_t base = m_now >> (shift + slot_bits) << (shift + slot_bits);
+            return base + (static_cast<boost::uint64_t>(lowest_bit(later)) << shift);
+        }
+    }
+
+    // Overflow list is cascaded when the whole wheel turns
+    const int shift = levels_count * slot_bits;
+    return ((m_now >> shift) + 1) << shift;
+}
+
+void timer_wheel::insert(index_type index)
+{
+    const boost::uint64_t expiry = m_nodes[index].expiry;
+
+    // Level is the highest group of bits that differs from the current time
+    const boost::uint64_t diff = expiry ^ m_now;
+    for ( int level = 0; level < levels_count; level++ )
+    {
+        const int shift = level_shift(level);
+        if ( diff >> (shift + slot_bits) == 0 )
+        {
+            const boost::uint32_t slot = (expiry >> shift) & slot_mask;
+            link(level * slots_count + slot, index);
+            m_occupied[level] |= boost::uint64_t(1) << slot;
+            return;
+        }
+    }
+
+    link(overflow_list, index);
+}
+
+void timer_wheel::link(index_type list, index_type index)
+{
+    node& n = m_nodes[index];
+    node& head = m_nodes[list];
+
+    n.list = list;
+    n.prev = head.prev;
+    n.next = list;
+    m_nodes[head.prev].next = index;
+    head.prev = index;
+}
+
+void timer_wheel::unlink(index_type index)
+{
+    node& n = m_nodes[index];
+    m_nodes[n.prev].next = n.next;
+    m_nodes[n.next].prev = n.prev;
+
+    const index_type list = n.list;
+    if ( list < overflow_list && m_nodes[list].next == list )
+        m_occupied[list / slots_count] &= ~(boost::uint64_t(1) << (list % slots_count));
+
+    n.list = no_list;
+}
+
+void timer_wheel::release(index_type index)
+{
+    node& n = m_nodes[index];
+    n.list = no_list;
+    n.generation++;
+    n.next = m_free;
+    m_free = index;
+    m_count--;
+}
+
+// Moves timers of the list to lower levels, timers of overflow list
+// that are still too far are inserted back to it
+void timer_wheel::cascade(index_type list)
+{
+    index_type index = m_nodes[list].next;
+    const index_type last = m_nodes[list].prev;
+    if ( index == list )
+        return;
+
+    while ( true )
+    {
+        const index_type next = m_nodes[index].next;
+        unlink(index);
+        insert(index);
+        if ( index == last )
+            break;
+        index = next;
+    }
+}
+
+void timer_wheel::tick()
+{
+    m_now++;
+
+    // Higher levels are cascaded first, so their timers can reach level 0
+    if ( (m_now & ((boost::uint64_t(1) << (levels_count * slot_bits)) - 1)) == 0 )
+        cascade(overflow_list);
+
+    for ( int level = levels_count - 1; level > 0; level-- )
+    {
+        const int shift = level_shift(level);
+        if ( (m_now & ((boost::uint64_t(1) << shift) - 1)) == 0 )
+            cascade(level * slots_count + ((m_now >> shift) & slot_mask));
+    }
+
+    const index_type list = static_cast<index_type>(m_now & slot_mask);
+    while ( m_nodes[list].next != list )
+    {
+        const index_type index = m_nodes[list].next;
+        unlink(index);
+        link(due_list, index);
+    }
+
+    fire_due();
+}
+
+void timer_wheel::fire_due()
+{
+    // Function can schedule or cancel timers, including due ones
+    while ( m_nodes[due_list].next != due_list )
+    {
+        const index_type index = m_nodes[due_list].next;
+        unlink(index);
+
+        boost::function<void()> fn;
+        fn.swap(m_nodes[index].fn);
+        release(index);
+
+        fn();
+    }
+}
+
+} // namespace detail
+} // namespace ui
+} // namespace boost
@@ -0,0 +1,324 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_UI_SOURCE
+
+#include <boost/ui/native/config.hpp>
+
+#include <boost/ui/detail/to_chars.hpp>
+
+#include <limits>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && \
+    (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#include <charconv>
+#endif
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define BOOST_UI_DETAIL_STD_TO_CHARS
+#else
+#include <stdio.h> // for snprintf()
+#endif
+
+namespace boost  {
+namespace ui     {
+namespace detail {
+
+namespace {
+
+const char g_digits[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+char* copy_chars(char* first, char* last, const char* begin, const char* end)
+{
+    const std::size_t count = end - begin;
+    if ( static_cast<std::size_t>(last - first) < count )
+        return NULL;
+
+    std::memcpy(first, begin, count);
+    return first + count;
+}
+
+#ifdef BOOST_UI_DETAIL_STD_TO_CHARS
+
+template <class T>
+char* to_chars_floating(char* first, char* last, T value,
+                        chars_format fmt, int precision)
+{
+    std::chars_format std_fmt = std::chars_format::general;
+    if ( fmt == chars_format::fixed )
+        std_fmt = std::chars_format::fixed;
+    else if ( fmt == chars_format::scientific )
+        std_fmt = std::chars_format::scientific;
+
+    std::to_chars_result result;
+    if ( precision >= 0 )
+        result = std::to_chars(first, last, value, std_fmt, precision);
+    else if ( fmt == chars_format::general )
+        result = std::to_chars(first, last, value);
+    else
+        result = std::to_chars(first, last, value, std_fmt);
+
+    return result.ec == std::errc() ? result.ptr : NULL;
+}
+
+#else // BOOST_UI_DETAIL_STD_TO_CHARS
+
+template <class T>
+class floating_traits
+{
+public:
+    static const char* length_modifier() { return ""; }
+    static T parse(const char* str) { return static_cast<T>(std::strtod(str, NULL)); }
+};
+
+template <>
+class floating_traits<long double>
+{
+public:
+    static const char* length_modifier() { return "L"; }
+    static long double parse(const char* str) { return std::strtold(str, NULL); }
+};
+
+// Returns count of written characters without null terminator
+// or -1 if buffer is too small
+template <class T>
+int print_floating(char* buffer, std::size_t size,
+                   char conversion, int precision, T value)
+{
+    char format[8] = "%.*";
+    std::strcat(format, floating_traits<T>::length_modifier());
+    const std::size_t length = std::strlen(format);
+    format[length] = conversion;
+    format[length + 1] = '\0';
+
+    const int count =
+#ifdef _MSC_VER
+        _snprintf
+#else
+        snprintf
+#endif
+            (buffer, size, format, precision, value);
+
+    if ( count < 0 || static_cast<std::size_t>(count) >= size )
+        return -1;
+
+    return count;
+}
+
+// Returns count of significant digits of the shortest representation
+// that is parsed back to the same value
+template <class T>
+int shortest_digits(T value, int& exponent)
+{
+    const int digits10 = std::numeric_limits<T>::digits10;
+    const int max_digits10 = 2 + std::numeric_limits<T>::digits * 30103 / 100000;
+
+    // Subnormal values have less precision than digits10
+    const bool subnormal = value != 0 &&
+        value < (std::numeric_limits<T>::min)() &&
+        value > -(std::numeric_limits<T>::min)();
+
+    char buffer[64];
+    int digits = digits10 > 0 && !subnormal ? digits10 : 1;
+    for ( ; digits < max_digits10; ++digits )
+    {
+        print_floating(buffer, sizeof buffer, 'e', digits - 1, value);
+        if ( floating_traits<T>::parse(buffer) == value )
+            break;
+    }
+    print_floating(buffer, sizeof buffer, 'e', digits - 1, value);
+
+    const char* e = std::strchr(buffer, 'e');
+    exponent = e ? std::atoi(e + 1) : 0;
+
+    // Trailing zeros of the mantissa aren't significant
+    if ( e )
+    {
+        const char* p = e - 1;
+        while ( digits > 1 && *p == '0' )
+        {
+            --digits;
+            --p;
+        }
+    }
+
+    return digits;
+}
+
+template <class T>
+char* to_chars_floating(char* first, char* last, T value,
+                        chars_format fmt, int precision)
+{
+    if ( value != value )
+    {
+        static const char nan[] = "nan";
+        return copy_chars(first, last, nan, nan + 3);
+    }
+    if ( value > (std::numeric_limits<T>::max)() ||
+         value < -(std::numeric_limits<T>::max)() )
+    {
+        static const char inf[] = "-inf";
+        return copy_chars(first, last, value < 0 ? inf : inf + 1, inf + 4);
+    }
+
+    char conversion = 'g';
+    if ( fmt == chars_format::fixed )
+        conversion = 'f';
+    else if ( fmt == chars_format::scientific )
+        conversion = 'e';
+
+    if ( precision < 0 )
+    {
+        int exponent = 0;
+        const int digits = shortest_digits(value, exponent);
+        if ( fmt == chars_format::general )
+        {
+            // Prefer fixed notation like std::to_chars() does
+            // if it isn't longer than scientific one
+            const int fixed_length = exponent + 1;
+            const int scientific_length = digits + (digits > 1 ? 1 : 0) +
+                                          (exponent >= 100 ? 5 : 4);
+            precision = exponent >= digits && fixed_length <= scientific_length
+                      ? fixed_length : digits;
+        }
+        else if ( fmt == chars_format::scientific )
+            precision = digits - 1;
+        else
+            precision = digits - 1 - exponent > 0 ? digits - 1 - exponent : 0;
+    }
+
+    // snprintf() writes null terminator that may not fit into the range
+    char buffer[64];
+    const int count = print_floating(buffer, sizeof buffer, conversion, precision, value);
+    if ( count >= 0 )
+        return copy_chars(first, last, buffer, buffer + count);
+
+    std::vector<char> heap_buffer(last - first + 1);
+    const int heap_count = print_floating(&heap_buffer[0], heap_buffer.size(),
+                                          conversion, precision, value);
+    if ( heap_count < 0 )
+        return NULL;
+
+    return copy_chars(first, last, &heap_buffer[0], &heap_buffer[0] + heap_count);
+}
+
+#endif // BOOST_UI_DETAIL_STD_TO_CHARS
+
+template <class T>
+void append_floating_detail(uistring& str, T value,
+                            chars_format fmt, int precision)
+{
+    char buffer[64];
+    const char* end = to_chars_floating(buffer, buffer + sizeof buffer,
+                                        value, fmt, precision);
+    if ( end )
+    {
+        str.append_ascii(buffer, end - buffer);
+        return;
+    }
+
+    // Fixed notation of huge values or high precision don't fit into stack
+    std::vector<char> heap_buffer(std::numeric_limits<T>::max_exponent10 -
+                                  std::numeric_limits<T>::min_exponent10 +
+                                  (precision > 0 ? precision : 0) + 64);
+    end = to_chars_floating(&heap_buffer[0], &heap_buffer[0] + heap_buffer.size(),
+                            value, fmt, precision);
+    if ( end )
+        str.append_ascii(&heap_buffer[0], end - &heap_buffer[0]);
+}
+
+} // unnamed namespace
+
+char* to_chars(char* first, char* last, unsigned long long value)
+{
+    char buffer[to_chars_integer_size];
+    char* const end = buffer + to_chars_integer_size;
+    char* p = end;
+
+    while ( value >= 100 )
+    {
+        const std::size_t i = static_cast<std::size_t>(value % 100) * 2;
+        value /= 100;
+        *--p = g_digits[i + 1];
+        *--p = g_digits[i];
+    }
+    if ( value < 10 )
+        *--p = static_cast<char>('0' + value);
+    else
+    {
+        const std::size_t i = static_cast<std::size_t>(value) * 2;
+        *--p = g_digits[i + 1];
+        *--p = g_digits[i];
+    }
+
+    return copy_chars(first, last, p, end);
+}
+
+char* to_chars(char* first, char* last, long long value)
+{
+    if ( value >= 0 )
+        return to_chars(first, last, static_cast<unsigned long long>(value));
+
+    if ( first == last )
+        return NULL;
+
+    *first = '-';
+    return to_chars(first + 1, last, 0ull - static_cast<unsigned long long>(value));
+}
+
+char* to_chars(char* first, char* last, float value,
+               chars_format fmt, int precision)
+{
+    return to_chars_floating(first, last, value, fmt, precision);
+}
+
+char* to_chars(char* first, char* last, double value,
+               chars_format fmt, int precision)
+{
+    return to_chars_floating(first, last, value, fmt, precision);
+}
+
+char* to_chars(char* first, char* last, long double value,
+               chars_format fmt, int precision)
+{
+    return to_chars_floating(first, last, value, fmt, precision);
+}
+
+void append_floating(uistring& str, float value,
+                     chars_format fmt, int precision)
+{
+    append_floating_detail(str, value, fmt, precision);
+}
+
+void append_floating(uistring& str, double value,
+                     chars_format fmt, int precision)
+{
+    append_floating_detail(str, value, fmt, precision);
+}
+
+void append_floating(uistring& str, long double value,
+                     chars_format fmt, int precision)
+{
+    append_floating_detail(str, value, fmt, precision);
+}
+
+} // namespace detail
+} // namespace ui
+} // namespace boost
@@ -13,7 +13,14 @@
 #include <boost/ui/native/string.hpp>
 #include <boost/ui/native/widget.hpp>
 
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
 #include <wx/window.h>
+#include <wx/time.h>
+#include <wx/timer.h>
 
 namespace boost {
 namespace ui    {
@@ -491,14 +498,12 @@ public:
 
 void widget::on_mouse_drag_raw(const boost::function<void()>& handler)
 {
-    const boost::function<bool(wxMouseEvent&)> filter = mouse_drag_filter();
-    native::bind_helper(*this, wxEVT_MOTION, handler, filter);
+    native::bind_helper(*this, wxEVT_MOTION, handler, mouse_drag_filter());
 }
 
 void widget::on_mouse_drag_event_raw(const boost::function<void(mouse_event&)>& handler)
 {
-    const boost::function<bool(wxMouseEvent&)> filter = mouse_drag_filter();
-    native::bind_event_helper(*this, wxEVT_MOTION, handler, filter);
+    native::bind_event_helper<mouse_event>(*this, wxEVT_MOTION, handler, mouse_drag_filter());
 }
 
 void widget::on_mouse_enter_raw(const boost::function<void()>& handler)
@@ -541,6 +546,185 @@ void widget::on_mouse_wheel_event_raw(const boost::function<void(wheel_event&)>&
     native::bind_event_helper(*this, wxEVT_MOUSEWHEEL, handler);
 }
 
+#if wxUSE_TIMER
+
+namespace {
+
+// Interval between calls of coalesced event handlers
+const int frame_ms = 16;
+
+} // unnamed namespace
+
+namespace native {
+
+// Merges mouse events and calls handler at most once per frame,
+// positions of merged events are recorded only if requested
+template <class UIEvent>
+class coalesced_event_functor
+{
+public:
+    coalesced_event_functor(const boost::function<void(UIEvent&)>& handler,
+                            bool record_history)
+        : m_state(boost::make_shared<state>(handler, record_history))
+    {}
+
+    void operator()(wxMouseEvent& wxevent)
+    {
+        wxevent.Skip();
+        m_state->push(wxevent);
+    }
+
+private:
+    static bool mergeable(const mouse_event&, const mouse_event&)
+    {
+        return true;
+    }
+
+    static bool mergeable(const wheel_event& pending, const wheel_event& latest)
+    {
+        return pending.m_horizontal == latest.m_horizontal;
+    }
+
+    static void merge(mouse_event& pending, const mouse_event& latest)
+    {
+        pending.m_x      = latest.m_x;
+        pending.m_y      = latest.m_y;
+        pending.m_left   = latest.m_left;
+        pending.m_right  = latest.m_right;
+        pending.m_middle = latest.m_middle;
+    }
+
+    static void merge(wheel_event& pending, const wheel_event& latest)
+    {
+        merge(static_cast<mouse_event&>(pending), static_cast<const mouse_event&>(latest));
+        pending.m_delta += latest.m_delta;
+    }
+
+    static void set_count(mouse_event& e, std::size_t count)
+    {
+        e.m_count = count;
+    }
+
+    static void set_history(mouse_event& e, const std::vector<point>* history)
+    {
+        e.m_history = history;
+    }
+
+    // Shared by copies of functor, is destroyed with the native widget
+    class state : public wxEvtHandler
+    {
+    public:
+        state(const boost::function<void(UIEvent&)>& handler, bool record_history)
+            : m_handler(handler), m_record_history(record_history),
+              m_timer(this), m_last_delivery(0), m_count(0)
+        {
+            Bind(wxEVT_TIMER, &state::on_timer, this);
+        }
+
+        void push(wxMouseEvent& wxevent)
+        {
+            UIEvent uievent;
+            event_functor_event<wxMouseEvent, UIEvent>::init(uievent, wxevent);
+
+            if ( m_count && !mergeable(m_pending, uievent) )
+                deliver();
+
+            if ( m_count )
+                merge(m_pending, uievent);
+            else
+                m_pending = uievent;
+
+            m_count++;
+            if ( m_record_history )
+                m_history.push_back(uievent.pos());
+
+            if ( !m_timer.IsRunning() )
+            {
+                const boost::uint64_t elapsed = (event_trace_now() - m_last_delivery) / 1000;
+                m_timer.StartOnce(elapsed >= static_cast<boost::uint64_t>(frame_ms) ?
+                                  0 : frame_ms - static_cast<int>(elapsed));
+            }
+        }
+
+    private:
+        void on_timer(wxTimerEvent&)
+        {
+            deliver();
+        }
+
+        // History buffers are swapped, so they keep capacity between frames
+        void deliver()
+        {
+            if ( !m_count )
+                return;
+
+            m_delivered.swap(m_history);
+            m_history.clear();
+
+            UIEvent uievent = m_pending;
+            set_count(uievent, m_count);
+            if ( m_record_history )
+                set_history(uievent, &m_delivered);
+            m_count = 0;
+            m_last_delivery = event_trace_now();
+
+            m_handler(uievent);
+        }
+
+        const boost::function<void(UIEvent&)> m_handler;
+        const bool m_record_history;
+        wxTimer m_timer;
+        boost::uint64_t m_last_delivery; // Microseconds of event_trace_now()
+
+        UIEvent m_pending;
+        std::size_t m_count;
+        std::vector<point> m_history;
+        std::vector<point> m_delivered;
+    };
+
+    boost::shared_ptr<state> m_state;
+};
+
+} // namespace native
+
+#endif // wxUSE_TIMER
+
+void widget::on_coalesced_mouse_move_event_raw(const boost::function<void(mouse_event&)>& handler)
+{
+    wxWindow* impl = native::from_widget(*this);
+    wxCHECK_RET(impl, "Widget should be created");
+
+#if wxUSE_TIMER
+    impl->Bind(wxEVT_MOTION, native::coalesced_event_functor<mouse_event>(handler, false));
+#else
+    native::bind_event_helper(*this, wxEVT_MOTION, handler);
+#endif
+}
+
+void widget::on_coalesced_mouse_wheel_event_raw(const boost::function<void(wheel_event&)>& handler)
+{
+    wxWindow* impl = native::from_widget(*this);
+    wxCHECK_RET(impl, "Widget should be created");
+
+#if wxUSE_TIMER
+    impl->Bind(wxEVT_MOUSEWHEEL, native::coalesced_event_functor<wheel_event>(handler, false));
+#else
+    native::bind_event_helper(*this, wxEVT_MOUSEWHEEL, handler);
+#endif
+}
+
+void widget::on_coalesced_mouse_history_event_raw(const boost::function<void(mouse_event&)>& handler)
+{
+    wxWindow* impl = native::from_widget(*this);
+    wxCHECK_RET(impl, "Widget should be created");
+
+#if wxUSE_TIMER
+    impl->Bind(wxEVT_MOTION, native::coalesced_event_functor<mouse_event>(handler, true));
+#else
+    native::bind_event_helper(*this, wxEVT_MOTION, handler);
+#endif
+}
+
 widget::native_handle_type widget::native_handle()
 {
     return m_detail_impl ? m_detail_impl->native_handle() : NULL;
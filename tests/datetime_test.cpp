@@ -15,6 +15,10 @@
 #include <boost/date_time/gregorian/gregorian.hpp>
 #endif
 
+#include <boost/bind.hpp>
+
+#include <vector>
+
 namespace ui = boost::ui;
 
 static void test_date_time_t(std::time_t actual, std::time_t expected)
@@ -380,6 +384,221 @@ void test_events()
 #endif
 }
 
+void set_flag(bool* flag)
+{
+    *flag = true;
+}
+
+void test_timeout_handle()
+{
+    BOOST_TEST(!ui::timeout_handle().pending());
+    BOOST_TEST(!ui::timeout_handle().cancel());
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    bool cancelled_called = false;
+    bool called = false;
+
+    ui::timeout_handle cancelled =
+        ui::on_timeout(std::chrono::milliseconds(10), &set_flag, &cancelled_called);
+    ui::timeout_handle handle =
+        ui::on_timeout(std::chrono::milliseconds(20), &set_flag, &called);
+
+    BOOST_TEST(cancelled.pending());
+    BOOST_TEST(cancelled.cancel());
+    BOOST_TEST(!cancelled.pending());
+    BOOST_TEST(!cancelled.cancel());
+    BOOST_TEST(handle.pending());
+
+    ui::event_loop loop;
+    ui::on_timeout(std::chrono::milliseconds(30), &ui::event_loop::exit, &loop);
+    loop.run();
+
+    BOOST_TEST(!cancelled_called);
+    BOOST_TEST(called);
+    BOOST_TEST(!handle.pending());
+    BOOST_TEST(!handle.cancel());
+#endif
+}
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+void run_nested_loop(const bool* outer_called, bool* nested_called)
+{
+    ui::event_loop loop;
+    ui::on_timeout(std::chrono::milliseconds(10), &set_flag, nested_called);
+    ui::on_timeout(std::chrono::milliseconds(30), &ui::event_loop::exit, &loop);
+    loop.run();
+
+    // Timeout that was scheduled before is called by the nested loop
+    BOOST_TEST(*outer_called);
+    BOOST_TEST(*nested_called);
+}
+#endif
+
+// Timeout functions can run nested event loops, such as modal dialogs
+void test_nested_timeout()
+{
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    bool outer_called = false;
+    bool nested_called = false;
+
+    ui::event_loop loop;
+    ui::on_timeout(std::chrono::milliseconds(10), &run_nested_loop,
+                   &outer_called, &nested_called);
+    ui::on_timeout(std::chrono::milliseconds(20), &set_flag, &outer_called);
+    ui::on_timeout(std::chrono::milliseconds(60), &ui::event_loop::exit, &loop);
+    loop.run();
+
+    BOOST_TEST(outer_called);
+    BOOST_TEST(nested_called);
+#endif
+}
+
+void test_debounce()
+{
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    typedef std::chrono::steady_clock clock;
+
+    int debounced = 0;
+    int throttled = 0;
+    int destroyed = 0;
+    clock::time_point last_call;
+    clock::time_point debounced_time;
+
+    auto debounced_fn = ui::debounce(std::chrono::milliseconds(20), [&]
+    {
+        debounced++;
+        debounced_time = clock::now();
+    });
+    auto throttled_fn = ui::throttle(std::chrono::milliseconds(20), [&] { throttled++; });
+
+    // The first throttled call of burst is called immediately
+    for ( int i = 0; i < 5; i++ )
+    {
+        debounced_fn();
+        throttled_fn();
+    }
+    BOOST_TEST_EQ(debounced, 0);
+    BOOST_TEST_EQ(throttled, 1);
+
+    // Postpones the debounced call after its timeout was scheduled
+    ui::on_timeout(std::chrono::milliseconds(10), [&]
+    {
+        last_call = clock::now();
+        debounced_fn();
+        throttled_fn();
+    });
+
+    // Pending timeout is cancelled with the handler
+    {
+        auto destroyed_fn = ui::debounce(std::chrono::milliseconds(10), [&] { destroyed++; });
+        destroyed_fn();
+    }
+
+    ui::event_loop loop;
+    ui::on_timeout(std::chrono::milliseconds(100), &ui::event_loop::exit, &loop);
+    loop.run();
+
+    BOOST_TEST_EQ(debounced, 1);
+    BOOST_TEST(debounced_time - last_call >= std::chrono::milliseconds(19));
+
+    // Calls during the interval are merged into one trailing call
+    BOOST_TEST_EQ(throttled, 2);
+
+    BOOST_TEST_EQ(destroyed, 0);
+#endif
+}
+
+void interval_tick(int* ticks, ui::event_loop* loop)
+{
+    if ( ++*ticks == 5 )
+        loop->exit();
+}
+
+void test_interval()
+{
+    BOOST_TEST(!ui::interval_handle().running());
+    BOOST_TEST(!ui::interval_handle().cancel());
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    // Millisecond and high resolution timers
+    const int periods[] = { 2000, 1500 };
+    for ( int i = 0; i < 2; i++ )
+    {
+        int ticks = 0;
+        ui::event_loop loop;
+        ui::interval_handle handle =
+            ui::on_interval(std::chrono::microseconds(periods[i]), &interval_tick, &ticks, &loop);
+        BOOST_TEST(handle.running());
+
+        loop.run();
+
+        BOOST_TEST(handle.cancel());
+        BOOST_TEST(!handle.running());
+        BOOST_TEST(!handle.cancel());
+        BOOST_TEST_EQ(ticks, 5);
+
+        const ui::interval_stats stats = handle.stats();
+        BOOST_TEST_EQ(stats.ticks, 5u);
+        BOOST_TEST_EQ(stats.lateness.count(), 5u);
+    }
+#endif
+}
+
+void push_value(std::vector<int>* values, int value)
+{
+    values->push_back(value);
+}
+
+// Queued event is processed before the next idle iteration
+void push_value_async(std::vector<int>* values, int value)
+{
+    values->push_back(value);
+    ui::call_async(boost::bind(&push_value, values, -value));
+}
+
+std::vector<int> run_idle_tasks()
+{
+    std::vector<int> values;
+    ui::event_loop loop;
+
+    ui::on_idle(boost::bind(&push_value_async, &values, 1));
+    ui::on_idle(boost::bind(&push_value, &values, 2));
+    ui::on_idle(boost::bind(&push_value, &values, 3), 1);
+    ui::on_idle(boost::bind(&ui::event_loop::exit, &loop), -1);
+    BOOST_TEST_EQ(ui::idle_tasks_count(), 4u);
+
+    loop.run();
+    BOOST_TEST_EQ(ui::idle_tasks_count(), 0u);
+
+    // Calls queued function if it wasn't called yet
+    ui::event_loop async_loop;
+    ui::call_async(boost::bind(&ui::event_loop::exit, &async_loop));
+    async_loop.run();
+
+    return values;
+}
+
+void test_idle()
+{
+    // One task per iteration
+    ui::idle_budget(boost::chrono::microseconds(0));
+    {
+        const int expected[] = { 3, 1, -1, 2 };
+        const std::vector<int> values = run_idle_tasks();
+        BOOST_TEST_ALL_EQ(values.begin(), values.end(), expected, expected + 4);
+    }
+
+    // All tasks in one iteration
+    ui::idle_budget(boost::chrono::seconds(10));
+    {
+        const int expected[] = { 3, 1, 2, -1 };
+        const std::vector<int> values = run_idle_tasks();
+        BOOST_TEST_ALL_EQ(values.begin(), values.end(), expected, expected + 4);
+    }
+
+    ui::idle_budget(boost::chrono::milliseconds(4));
+}
+
 int ui_main()
 {
     ui::dialog dlg("Date and time test dialog");
@@ -389,6 +608,11 @@ int ui_main()
         << test_time_picker(dlg)
         ;
     test_events();
+    test_timeout_handle();
+    test_nested_timeout();
+    test_debounce();
+    test_interval();
+    test_idle();
 
     //dlg.show_modal();
 
@@ -0,0 +1,156 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/ui.hpp>
+#include <boost/ui/native/all.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/detail/lightweight_main.hpp>
+
+#include <wx/wx.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ui = boost::ui;
+
+void test_histogram()
+{
+    ui::latency_histogram h;
+    BOOST_TEST_EQ(h.count(), 0u);
+    BOOST_TEST_EQ(h.min_value(), 0u);
+    BOOST_TEST_EQ(h.max_value(), 0u);
+    BOOST_TEST_EQ(h.value_at_percentile(50), 0u);
+
+    for ( int i = 1; i <= 100; i++ )
+        h.record(i);
+
+    BOOST_TEST_EQ(h.count(), 100u);
+    BOOST_TEST_EQ(h.min_value(), 1u);
+    BOOST_TEST_EQ(h.max_value(), 100u);
+    BOOST_TEST_EQ(h.mean(), 50.5);
+    BOOST_TEST_EQ(h.value_at_percentile(0), 1u);
+    BOOST_TEST_EQ(h.value_at_percentile(50), 50u);
+    BOOST_TEST_EQ(h.value_at_percentile(100), 100u);
+
+    // Relative error of large values is less than 1/32
+    const boost::uint64_t p99 = h.value_at_percentile(99);
+    BOOST_TEST_GE(p99, 99u);
+    BOOST_TEST_LE(p99, 99u + 99u / 32);
+
+    h.record(1000000);
+    BOOST_TEST_EQ(h.max_value(), 1000000u);
+    BOOST_TEST_EQ(h.value_at_percentile(100), 1000000u);
+
+    h.clear();
+    BOOST_TEST_EQ(h.count(), 0u);
+    BOOST_TEST_EQ(h.max_value(), 0u);
+}
+
+void count_call(int* calls)
+{
+    ++*calls;
+}
+
+// Returns statistics of the first handler which name starts with @a prefix
+const ui::event_trace::handler_stats* find_handler(
+    const std::vector<ui::event_trace::handler_stats>& handlers, const std::string& prefix)
+{
+    for ( std::size_t i = 0; i < handlers.size(); i++ )
+        if ( handlers[i].name.string().compare(0, prefix.size(), prefix) == 0 )
+            return &handlers[i];
+
+    return NULL;
+}
+
+void test_trace(ui::widget& parent)
+{
+    BOOST_TEST(!ui::event_trace::running());
+
+    ui::event_trace::start();
+    BOOST_TEST(ui::event_trace::running());
+    ui::event_trace::stop();
+    BOOST_TEST(!ui::event_trace::running());
+
+    ui::event_trace::clear();
+    BOOST_TEST(ui::event_trace::handlers().empty());
+    BOOST_TEST_EQ(ui::event_trace::dropped_count(), 0u);
+
+    {
+        std::ostringstream ss;
+        ui::event_trace::write_chrome_trace(ss);
+        BOOST_TEST_EQ(ss.str(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n");
+    }
+
+    int presses = 0;
+    ui::button b(parent, "Traced");
+    b.on_press(&count_call, &presses);
+
+    // Only the first invocation is stored, later ones are dropped
+    ui::event_trace::start(1);
+
+    wxWindow* window = ui::native::from_widget(b);
+    wxCommandEvent event(wxEVT_BUTTON, window->GetId());
+    event.SetEventObject(window);
+    window->ProcessWindowEvent(event);
+
+    ui::event_loop loop;
+    ui::call_async(&ui::event_loop::exit, &loop);
+    loop.run();
+
+    ui::event_trace::stop();
+
+    BOOST_TEST_EQ(presses, 1);
+
+    const std::vector<ui::event_trace::handler_stats> handlers = ui::event_trace::handlers();
+
+    const ui::event_trace::handler_stats* press = find_handler(handlers, "press wxButton");
+    BOOST_TEST(press);
+    if ( press )
+    {
+        BOOST_TEST_EQ(press->duration.count(), 1u);
+
+        // Event without native timestamp
+        BOOST_TEST_EQ(press->queue_latency.count(), 0u);
+    }
+
+    const ui::event_trace::handler_stats* async = find_handler(handlers, "call_async");
+    BOOST_TEST(async);
+    if ( async )
+    {
+        BOOST_TEST_EQ(async->duration.count(), 1u);
+        BOOST_TEST_EQ(async->queue_latency.count(), 1u);
+    }
+
+    BOOST_TEST_GE(ui::event_trace::dropped_count(), 1u);
+
+    std::ostringstream ss;
+    ui::event_trace::write_chrome_trace(ss);
+    const std::string json = ss.str();
+
+    const std::string record = "\"ph\":\"X\"";
+    const std::string::size_type pos = json.find(record);
+    BOOST_TEST_NE(pos, std::string::npos);
+    BOOST_TEST_EQ(json.find(record, pos + 1), std::string::npos);
+    BOOST_TEST_NE(json.find("\"name\":\"press\""), std::string::npos);
+
+    ui::event_trace::clear();
+}
+
+int ui_main()
+{
+    ui::dialog dlg("Event trace test dialog");
+
+    test_histogram();
+    test_trace(dlg);
+
+    return boost::report_errors();
+}
+
+int cpp_main(int argc, char* argv[])
+{
+    return ui::entry(&ui_main, argc, argv);
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/ui.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/detail/lightweight_main.hpp>
+
+#include <string>
+
+#ifndef BOOST_WINDOWS
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ui = boost::ui;
+
+#ifndef BOOST_WINDOWS
+
+struct pipe_reader
+{
+    int fd;
+    ui::fd_watcher watcher;
+    ui::event_loop loop;
+    std::string received;
+    int reads;
+};
+
+void on_read(pipe_reader* reader)
+{
+    reader->reads++;
+
+    char buffer[16];
+    ssize_t size;
+    while ( (size = ::read(reader->fd, buffer, sizeof(buffer))) > 0 )
+        reader->received.append(buffer, size);
+
+    if ( reader->received.size() >= 3 )
+    {
+        // Closing from own handler
+        reader->watcher.close();
+        reader->loop.exit();
+    }
+}
+
+void test_fd_watcher()
+{
+    ui::fd_watcher empty;
+    BOOST_TEST(!empty.is_open());
+    BOOST_TEST_EQ(empty.fd(), -1);
+
+    if ( !ui::fd_watcher::is_supported() )
+        return;
+
+    int fds[2];
+    BOOST_TEST_EQ(::pipe(fds), 0);
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    pipe_reader reader;
+    reader.fd = fds[0];
+    reader.reads = 0;
+    reader.watcher.create(fds[0]).on_read(&on_read, &reader);
+    BOOST_TEST(reader.watcher.is_open());
+    BOOST_TEST_EQ(reader.watcher.fd(), fds[0]);
+
+    BOOST_TEST_EQ(::write(fds[1], "abc", 3), 3);
+    reader.loop.run();
+
+    BOOST_TEST_EQ(reader.received, "abc");
+    BOOST_TEST_GE(reader.reads, 1);
+    BOOST_TEST(!reader.watcher.is_open());
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+#endif
+
+int ui_main()
+{
+#ifndef BOOST_WINDOWS
+    test_fd_watcher();
+#endif
+
+    return boost::report_errors();
+}
+
+int cpp_main(int argc, char* argv[])
+{
+    return ui::entry(&ui_main, argc, argv);
+}
@@ -9,6 +9,8 @@
 #include <boost/core/lightweight_test.hpp>
 #include <boost/detail/lightweight_main.hpp>
 
+#include <complex>
+
 namespace ui = boost::ui;
 
 void test_output(ui::log_string& l)
@@ -21,8 +23,123 @@ void test_output(ui::log_string& l)
         ;
 }
 
+void test_numbers()
+{
+    ui::uistring str;
+    ui::log_string(str).noquotes()
+        << short(-1) << 2u << -3l << 4ul << -5ll << 6ull
+        << 0.5f << 1e100 << 0.25L << false;
+    BOOST_TEST_EQ(str, "-1 2 -3 4 -5 6 0.5 1e+100 0.25 false");
+}
+
+struct long_output {};
+
+std::ostream& operator<<(std::ostream& os, const long_output&)
+{
+    return os << std::string(1000, 'x') << 'y';
+}
+
+void test_generic()
+{
+    ui::uistring str;
+    ui::log_string(str) << long_output() << std::complex<int>(1, 2);
+    BOOST_TEST_EQ(str, std::string(1000, 'x') + "y (1,2)");
+}
+
+void test_location()
+{
+    for ( int i = 0; i < 2; i++ )
+    {
+        ui::uistring str;
+        ui::log_string(str).location("file.cpp", 12, "fn") << i;
+        BOOST_TEST_EQ(str, i == 0 ? "file.cpp[12] fn: 0" : "file.cpp[12] fn: 1");
+    }
+    {
+        ui::uistring str;
+        ui::log_string(str).location("file.cpp");
+        BOOST_TEST_EQ(str, "file.cpp:");
+    }
+    {
+        // Other contents at the same address
+        char file[] = "a.cpp";
+        ui::uistring str1;
+        ui::log_string(str1).location(file, 1);
+        file[0] = 'b';
+        ui::uistring str2;
+        ui::log_string(str2).location(file, 1);
+        BOOST_TEST_EQ(str1, "a.cpp[1]:");
+        BOOST_TEST_EQ(str2, "b.cpp[1]:");
+    }
+}
+
+int g_evaluated = 0;
+
+int evaluate()
+{
+    return ++g_evaluated;
+}
+
+void test_level()
+{
+    const int level = ui::log::min_level();
+
+    ui::log::min_level(BOOST_UI_LOG_LEVEL_INFO);
+    BOOST_TEST(ui::log::enabled(BOOST_UI_LOG_LEVEL_FATAL));
+    BOOST_TEST(ui::log::enabled(BOOST_UI_LOG_LEVEL_INFO));
+    BOOST_TEST(!ui::log::enabled(BOOST_UI_LOG_LEVEL_DEBUG));
+
+    // Arguments of disabled messages aren't evaluated
+    BOOST_UI_LOG_VERBOSE << evaluate();
+    BOOST_UI_LOG_DEBUG << evaluate();
+    if ( g_evaluated == 0 )
+        BOOST_UI_LOG_TRACE << evaluate();
+    else
+        evaluate();
+    BOOST_TEST_EQ(g_evaluated, 0);
+
+    ui::log::min_level(level);
+}
+
+void test_rate_limit()
+{
+    g_evaluated = 0;
+    const unsigned long long rate_limited = ui::log::rate_limited_count();
+
+    // Burst of 2 messages from the same call site
+    ui::log::rate_limit(BOOST_UI_LOG_LEVEL_VERBOSE, 0.001, 2);
+    for ( int i = 0; i < 5; i++ )
+        BOOST_UI_LOG_VERBOSE << evaluate();
+    ui::log::rate_limit(BOOST_UI_LOG_LEVEL_VERBOSE, 0);
+
+    BOOST_TEST_EQ(g_evaluated, 2);
+    BOOST_TEST_EQ(ui::log::rate_limited_count() - rate_limited, 3u);
+
+    const unsigned long long repeated = ui::log::repeated_count();
+
+    ui::log::collapse_repeats(BOOST_UI_LOG_LEVEL_VERBOSE);
+    for ( int i = 0; i < 6; i++ )
+    {
+        // Pending notice is logged without the next different message,
+        // the same message is still collapsed after it
+        if ( i == 5 )
+            ui::log::flush_repeats();
+
+        BOOST_UI_LOG_VERBOSE << "repeated" << i / 3;
+    }
+    ui::log::collapse_repeats(BOOST_UI_LOG_LEVEL_VERBOSE, false);
+
+    BOOST_TEST_EQ(ui::log::repeated_count() - repeated, 4u);
+    ui::log::flush_repeats();
+}
+
 int cpp_main(int, char*[])
 {
+    test_numbers();
+    test_generic();
+    test_location();
+    test_level();
+    test_rate_limit();
+
     {
         ui::uistring str;
         test_output(ui::log_string(str).nospaces().noquotes());
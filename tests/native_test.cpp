@@ -11,6 +11,10 @@
 
 #include <wx/wx.h>
 
+#include <sstream>
+#include <string>
+#include <vector>
+
 namespace ui = boost::ui;
 
 void test_label(ui::widget& parent)
@@ -30,11 +34,109 @@ void test_label(ui::widget& parent)
     }
 }
 
+struct coalesced_calls
+{
+    std::vector<std::size_t> counts;
+    std::vector<std::size_t> history_sizes;
+};
+
+void on_coalesced(coalesced_calls* calls, ui::mouse_event& e)
+{
+    calls->counts.push_back(e.count());
+    calls->history_sizes.push_back(e.history().size());
+}
+
+void test_coalesced_events(ui::widget& parent)
+{
+    ui::panel p(parent);
+
+    coalesced_calls moves;
+    coalesced_calls history;
+    p.on_coalesced_mouse_move_event(&on_coalesced, &moves);
+    p.on_coalesced_mouse_history_event(&on_coalesced, &history);
+
+    wxWindow* window = ui::native::from_widget(p);
+    for ( int i = 0; i < 5; i++ )
+    {
+        wxMouseEvent wxevent(wxEVT_MOTION);
+        wxevent.SetEventObject(window);
+        wxevent.SetPosition(wxPoint(i, i));
+        window->GetEventHandler()->ProcessEvent(wxevent);
+    }
+
+    // Handlers are called by the timer of the next frame
+    BOOST_TEST(moves.counts.empty());
+    BOOST_TEST(history.counts.empty());
+
+    ui::event_loop loop;
+    ui::on_timeout(100, boost::bind(&ui::event_loop::exit, &loop));
+    loop.run();
+
+    BOOST_TEST_EQ(moves.counts.size(), 1u);
+    BOOST_TEST_EQ(history.counts.size(), 1u);
+    if ( moves.counts.size() == 1 && history.counts.size() == 1 )
+    {
+        BOOST_TEST_EQ(moves.counts[0], 5u);
+        BOOST_TEST_EQ(moves.history_sizes[0], 0u);
+        BOOST_TEST_EQ(history.counts[0], 5u);
+        BOOST_TEST_EQ(history.history_sizes[0], 5u);
+    }
+}
+
+void count_call(int* calls)
+{
+    ++*calls;
+}
+
+void test_input_replay(ui::widget& parent)
+{
+    ui::panel p(parent);
+
+    int presses = 0;
+    p.on_left_mouse_down(&count_call, &presses);
+
+    wxWindow* window = ui::native::from_widget(p);
+
+    ui::input_recorder recorder;
+    recorder.start();
+    for ( int i = 0; i < 3; i++ )
+    {
+        wxMouseEvent wxevent(wxEVT_LEFT_DOWN);
+        wxevent.SetEventObject(window);
+        wxevent.SetPosition(wxPoint(i, i));
+        window->GetEventHandler()->ProcessEvent(wxevent);
+    }
+    recorder.stop();
+
+    BOOST_TEST_EQ(recorder.size(), 3u);
+    BOOST_TEST_EQ(presses, 3);
+
+    std::stringstream ss;
+    recorder.save(ss);
+    const std::string saved = ss.str();
+
+    ui::input_replayer replayer;
+    BOOST_TEST(replayer.load(ss));
+    BOOST_TEST_EQ(replayer.size(), 3u);
+
+    replayer.speed(0).replay();
+    BOOST_TEST_EQ(presses, 6);
+    BOOST_TEST_EQ(replayer.missing_count(), 0u);
+    BOOST_TEST_EQ(replayer.latency().count(), 3u);
+
+    // Lines before the invalid one aren't kept
+    std::istringstream invalid(saved + "invalid line\n");
+    BOOST_TEST(!replayer.load(invalid));
+    BOOST_TEST_EQ(replayer.size(), 0u);
+}
+
 int ui_main()
 {
     ui::dialog dlg("Title");
 
     test_label(dlg);
+    test_coalesced_events(dlg);
+    test_input_replay(dlg);
 
     //dlg.show_modal();
 
@@ -68,6 +68,39 @@ int cpp_main(int, char*[])
         ss  << ptr;
         BOOST_TEST_NE(ss.str().wstring().find(L"42"), -1);
     }
+    {
+        ui::uiostringstream ss;
+        ss << 0.1 << ' ' << 1.5f << ' ' << -7 << ' ' << 18446744073709551615ull;
+        BOOST_TEST(ss.str() == "0.1 1.5 -7 18446744073709551615");
+    }
+    {
+        ui::uiostringstream ss;
+        BOOST_TEST(ss.format() == ui::chars_format::general);
+        BOOST_TEST_EQ(ss.precision(), -1);
+
+        ss.format(ui::chars_format::fixed).precision(2);
+        ss << 3.14159 << ' ' << 2.0;
+        ss.format(ui::chars_format::scientific).precision(-1);
+        ss << ' ' << 1500.0;
+        BOOST_TEST(ss.str() == "3.14 2.00 1.5e+03");
+    }
+    {
+        ui::uiostringstream ss;
+        ss.reserve(100);
+        ss.append_format("{} + {} = {}", 1, 2.5, "3.5");
+        ss.append_format(L"; {{{}}} {}", L'x');
+        BOOST_TEST(ss.str() == "1 + 2.5 = 3.5; {x} {}");
+
+        const ui::uistring str = ss.take();
+        BOOST_TEST(str == "1 + 2.5 = 3.5; {x} {}");
+        BOOST_TEST(ss.str() == "");
+
+#ifndef BOOST_NO_CXX11_REF_QUALIFIERS
+        ss << "moved";
+        BOOST_TEST(std::move(ss).str() == "moved");
+        BOOST_TEST(ss.str() == "");
+#endif
+    }
     {
         ui::uiostringstream ss1("1");
         ui::uiostringstream ss2("2");
@@ -272,6 +272,27 @@ void test_touistring()
     BOOST_TEST_EQ(ui::to_uistring(2.3).wstring().find(L"2.3"), 0);
     BOOST_TEST_EQ(ui::to_uistring(3.4l).wstring().find(L"3.4"), 0);
     BOOST_TEST_EQ(ui::uistring("a") + ui::to_uistring(1), "a1");
+
+    BOOST_TEST_EQ(ui::to_uistring(0), "0");
+    BOOST_TEST_EQ(ui::to_uistring(-9223372036854775807ll - 1), "-9223372036854775808");
+    BOOST_TEST_EQ(ui::to_uistring(18446744073709551615ull), "18446744073709551615");
+
+    BOOST_TEST_EQ(ui::to_uistring(1.2f), "1.2");
+    BOOST_TEST_EQ(ui::to_uistring(2.3), "2.3");
+    BOOST_TEST_EQ(ui::to_uistring(0.1 + 0.2), "0.30000000000000004");
+    BOOST_TEST_EQ(ui::to_uistring(100.0), "100");
+    BOOST_TEST_EQ(ui::to_uistring(1e20), "1e+20");
+    BOOST_TEST_EQ(ui::to_uistring(-0.5), "-0.5");
+
+    BOOST_TEST_EQ(ui::to_uistring(2.3, ui::chars_format::fixed, 3), "2.300");
+    BOOST_TEST_EQ(ui::to_uistring(1e20, ui::chars_format::fixed), "100000000000000000000");
+    BOOST_TEST_EQ(ui::to_uistring(1234.5, ui::chars_format::scientific), "1.2345e+03");
+    BOOST_TEST_EQ(ui::to_uistring(1234.5, ui::chars_format::scientific, 1), "1.2e+03");
+    BOOST_TEST_EQ(ui::to_uistring(1e300, ui::chars_format::fixed, 2).wstring().size(), 304u);
+
+    ui::uistring str("x=");
+    str.append_ascii("12345", 3);
+    BOOST_TEST_EQ(str, "x=123");
 }
 
 template <class CharT>
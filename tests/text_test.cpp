@@ -0,0 +1,94 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/ui/text.hpp>
+#include <boost/ui/string_io.hpp>
+
+#include <boost/bind.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/detail/lightweight_main.hpp>
+
+#include <string>
+
+namespace ui = boost::ui;
+
+void append_chunk(std::wstring& result, const wchar_t* data, std::size_t size)
+{
+    result.append(data, size);
+}
+
+void test_uitext_api()
+{
+    {
+        ui::uitext text;
+        BOOST_TEST(text.empty());
+        BOOST_TEST_EQ(text.size(), 0u);
+        BOOST_TEST_EQ(text.str(), "");
+    }
+    {
+        ui::uitext text(ui::uistring("world"));
+        text.insert(0, ui::uistring("Hello "));
+        text += ui::uistring("!");
+        BOOST_TEST_EQ(text.str(), "Hello world!");
+        BOOST_TEST_EQ(text.size(), 12u);
+        BOOST_TEST(text[4] == L'o');
+
+        const ui::uitext copy = text;
+        text.erase(5, 6);
+        BOOST_TEST_EQ(text.str(), "Hello!");
+        BOOST_TEST_EQ(copy.str(), "Hello world!");
+
+        BOOST_TEST_EQ(copy.substr(6).str(), "world!");
+        BOOST_TEST_EQ(copy.substr(6, 5).str(), "world");
+        BOOST_TEST_EQ((text + copy.substr(5)).str(), "Hello! world!");
+
+        text.erase(2);
+        BOOST_TEST_EQ(text.str(), "He");
+
+        text.clear();
+        BOOST_TEST(text.empty());
+    }
+}
+
+void test_uitext_large()
+{
+    std::wstring expected;
+    ui::uitext text;
+    for ( int i = 0; i < 10000; i++ )
+    {
+        const std::wstring line = ui::to_uistring(i).wstring() + L" line\n";
+        expected += line;
+        text.append(line.data(), line.size());
+    }
+    BOOST_TEST_EQ(text.size(), expected.size());
+    BOOST_TEST(text.str().wstring() == expected);
+
+    for ( std::size_t pos = 0; pos < expected.size(); pos += 997 )
+    {
+        expected.insert(pos, L"<>");
+        text.insert(pos, ui::uistring(L"<>"));
+    }
+    for ( std::size_t pos = 0; pos < expected.size(); pos += 1499 )
+    {
+        expected.erase(pos, 7);
+        text.erase(pos, 7);
+    }
+    BOOST_TEST(text.str().wstring() == expected);
+    BOOST_TEST(text.substr(12345, 678).str().wstring() == expected.substr(12345, 678));
+    BOOST_TEST(text[54321] == expected[54321]);
+
+    std::wstring chunks;
+    text.for_each_chunk(boost::bind(&append_chunk, boost::ref(chunks), _1, _2));
+    BOOST_TEST(chunks == expected);
+}
+
+int cpp_main(int, char*[])
+{
+    test_uitext_api();
+    test_uitext_large();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,339 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/ui.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/detail/lightweight_main.hpp>
+
+#include <vector>
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#endif
+
+namespace ui = boost::ui;
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+
+const int threads_count = 8;
+const int calls_count = 10000;
+
+// Accessed from the UI thread only
+std::vector< std::vector<int> > g_calls(threads_count);
+std::vector<int> g_latest(threads_count + 1, -1);
+int g_latest_runs = 0;
+
+void push_call(int thread, int value)
+{
+    g_calls[thread].push_back(value);
+}
+
+void set_latest(int index, int value)
+{
+    g_latest[index] = value;
+    g_latest_runs++;
+}
+
+// Runs event loop until all previously queued functions are called
+void process_queued()
+{
+    ui::event_loop loop;
+    ui::call_async(&ui::event_loop::exit, &loop);
+    loop.run();
+}
+
+template <class F>
+void run_threads(F f)
+{
+    std::vector<std::thread> threads;
+    for ( int i = 0; i < threads_count; i++ )
+        threads.push_back(std::thread(f, i));
+    for ( int i = 0; i < threads_count; i++ )
+        threads[i].join();
+}
+
+void test_call_async()
+{
+    run_threads([](int thread)
+    {
+        for ( int i = 0; i < calls_count; i++ )
+            ui::call_async(&push_call, thread, i);
+    });
+
+    BOOST_TEST_EQ(ui::async_queue_depth(), std::size_t(threads_count * calls_count));
+
+    process_queued();
+
+    BOOST_TEST_EQ(ui::async_queue_depth(), 0u);
+
+    // Functions of each thread are called in order
+    for ( int thread = 0; thread < threads_count; thread++ )
+    {
+        BOOST_TEST_EQ(g_calls[thread].size(), std::size_t(calls_count));
+        for ( int i = 0; i < calls_count && i < int(g_calls[thread].size()); i++ )
+            BOOST_TEST_EQ(g_calls[thread][i], i);
+    }
+
+    const ui::async_queue_stats stats = ui::async_stats();
+    BOOST_TEST_GE(stats.max_depth, std::size_t(threads_count * calls_count));
+    BOOST_TEST_GE(stats.calls, boost::uint64_t(threads_count * calls_count));
+    BOOST_TEST_GT(stats.batches, 0u);
+    BOOST_TEST_EQ(stats.drain_time.count(), stats.batches);
+}
+
+void test_call_async_latest()
+{
+    const boost::uint64_t superseded = ui::async_stats().superseded;
+
+    // Each thread updates its own key and all threads update the shared one
+    run_threads([](int thread)
+    {
+        for ( int i = 0; i < calls_count; i++ )
+        {
+            ui::call_async_latest(&g_latest[thread], &set_latest, thread, i);
+            ui::call_async_latest(&g_latest[threads_count], &set_latest,
+                                  threads_count, i);
+        }
+    });
+
+    process_queued();
+
+    for ( int thread = 0; thread < threads_count; thread++ )
+        BOOST_TEST_EQ(g_latest[thread], calls_count - 1);
+    BOOST_TEST_EQ(g_latest[threads_count], calls_count - 1);
+
+    // Burst of updates of each key runs once
+    BOOST_TEST_EQ(g_latest_runs, threads_count + 1);
+    BOOST_TEST_EQ(ui::async_stats().superseded - superseded,
+                  boost::uint64_t(2 * threads_count * calls_count - g_latest_runs));
+
+    // Key can be reused after its function was called
+    ui::call_async_latest(&g_latest[0], &set_latest, 0, -2);
+    process_queued();
+    BOOST_TEST_EQ(g_latest[0], -2);
+}
+
+int g_result = 0;
+
+void test_executor()
+{
+    ui::thread_pool pool(4);
+    BOOST_TEST_EQ(pool.size(), 4u);
+    BOOST_TEST(!pool.running_in_this_thread());
+
+    ui::executor ui_ex;
+    BOOST_TEST(ui_ex.running_in_this_thread());
+
+    ui::event_loop loop;
+
+    // Computes in the pool, then updates result in the UI thread
+    pool.get_executor().post([&]
+    {
+        const int value = pool.running_in_this_thread() ? 6 * 7 : -1;
+        ui_ex.post([&loop, value]
+        {
+            g_result = value;
+            loop.exit();
+        });
+    });
+    loop.run();
+    BOOST_TEST_EQ(g_result, 42);
+
+    // Dispatch calls function immediately in the same thread
+    g_result = 0;
+    ui_ex.dispatch([] { g_result = 1; });
+    BOOST_TEST_EQ(g_result, 1);
+
+#if !defined(BOOST_NO_CXX11_HDR_FUTURE) && !defined(BOOST_NO_CXX11_DECLTYPE)
+    std::future<int> f = ui::async(pool, [] { return 5; });
+    BOOST_TEST_EQ(f.get(), 5);
+#endif
+}
+
+void test_work_stealing()
+{
+    std::atomic<int> calls(0);
+    {
+        // Shared queue is bounded, queues of pool threads aren't
+        ui::thread_pool pool(4, 2);
+        BOOST_TEST_EQ(pool.capacity(), 2u);
+
+        for ( int i = 0; i < 100; i++ )
+        {
+            pool.post([&pool, &calls]
+            {
+                for ( int j = 0; j < 10; j++ )
+                    pool.post([&calls] { calls++; });
+            });
+        }
+    }
+    BOOST_TEST_EQ(calls.load(), 1000);
+}
+
+void test_cancellation()
+{
+    ui::cancellation_token token;
+    BOOST_TEST(!token.cancelled());
+    token.cancel();
+    BOOST_TEST(token.cancelled());
+
+    int calls = 0;
+    ui::thread_pool pool(1);
+    ui::event_loop loop;
+
+    pool.post(token, [&calls] { calls++; });
+    pool.post(ui::cancellation_token(), [&calls, &loop]
+    {
+        calls += 10;
+        ui::call_async(&ui::event_loop::exit, &loop);
+    });
+    loop.run();
+    BOOST_TEST_EQ(calls, 10);
+}
+
+void test_progress_reporter()
+{
+    ui::cancellation_token owner_token;
+    {
+        ui::dialog dlg("Title");
+        ui::hprogress_bar bar(dlg);
+        ui::progress_reporter reporter(bar);
+        owner_token = ui::cancellation_token(bar);
+        BOOST_TEST(!reporter.token().cancelled());
+
+        {
+            ui::thread_pool pool(2);
+            pool.post(reporter.token(), [reporter]
+            {
+                for ( int i = 0; i <= 1000; i++ )
+                    reporter.report(i / 10);
+                reporter.report(200); // Clamped
+            });
+        }
+
+        // Throttled update is applied within a frame
+        ui::event_loop loop;
+        ui::on_timeout(std::chrono::milliseconds(100), &ui::event_loop::exit, &loop);
+        loop.run();
+        BOOST_TEST_EQ(bar.value(), 100);
+
+        BOOST_TEST(!owner_token.cancelled());
+    }
+    BOOST_TEST(owner_token.cancelled());
+}
+
+int g_remote_calls = 0;
+
+void count_remote_call(ui::label&)
+{
+    g_remote_calls++;
+}
+
+void test_remote()
+{
+    ui::dialog dlg("Title");
+    ui::label lbl(dlg, "Initial");
+
+    {
+        ui::remote<ui::label> status(lbl);
+
+        // Changes of the same property are merged into one batch
+        std::thread([status]() mutable
+        {
+            for ( int i = 0; i <= 100; i++ )
+            {
+                status.text(ui::uistring(std::to_string(i)));
+                status.set(&g_remote_calls, &count_remote_call);
+            }
+            status.resize(40, 20).disable();
+        }).join();
+    }
+    BOOST_TEST_EQ(lbl.text(), "Initial");
+
+    process_queued();
+    BOOST_TEST_EQ(lbl.text(), "100");
+    BOOST_TEST_EQ(g_remote_calls, 1);
+    BOOST_TEST_EQ(lbl.width(), 40);
+    BOOST_TEST(!lbl.is_enabled());
+}
+
+void test_destroyed_remote()
+{
+    std::unique_ptr< ui::remote<ui::label> > status;
+    {
+        ui::dialog dlg("Title");
+        ui::label lbl(dlg);
+        status.reset(new ui::remote<ui::label>(lbl));
+    }
+
+    // Proxy is released by other thread, change is ignored
+    std::thread([&status]
+    {
+        status->text("Ignored");
+        status.reset();
+    }).join();
+    process_queued();
+}
+
+#ifdef BOOST_UI_HAS_COROUTINES
+
+bool g_on_pool = false;
+bool g_on_ui = false;
+
+ui::task hop(ui::thread_pool& pool, ui::event_loop& loop)
+{
+    co_await ui::resume_on_pool(pool);
+    g_on_pool = pool.running_in_this_thread();
+
+    co_await ui::resume_on_ui();
+    g_on_ui = ui::executor().running_in_this_thread();
+
+    co_await ui::delay(std::chrono::milliseconds(1));
+    loop.exit();
+}
+
+void test_coroutine()
+{
+    ui::thread_pool pool(2);
+    ui::event_loop loop;
+
+    hop(pool, loop);
+    loop.run();
+
+    BOOST_TEST(g_on_pool);
+    BOOST_TEST(g_on_ui);
+}
+
+#endif
+
+#endif
+
+int ui_main()
+{
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+    test_call_async();
+    test_call_async_latest();
+    test_executor();
+    test_work_stealing();
+    test_cancellation();
+    test_progress_reporter();
+    test_remote();
+    test_destroyed_remote();
+#ifdef BOOST_UI_HAS_COROUTINES
+    test_coroutine();
+#endif
+#endif
+
+    return boost::report_errors();
+}
+
+int cpp_main(int argc, char* argv[])
+{
+    return ui::entry(&ui_main, argc, argv);
+}
@@ -111,6 +111,8 @@ void test_window(ui::window& parent)
     win.on_mouse_drag(&my_handlers::my_handler, &a);
     win.on_mouse_drag_event(&my_handlers::my_handler_event, &a);
     win.on_mouse_drag_event(&my_handlers::my_handler_event_1, &a, 9);
+    win.on_coalesced_mouse_move_event(&my_handler_event);
+    win.on_coalesced_mouse_move_event(&my_handlers::my_handler_event_1, &a, 8);
 
     //win.show_modal();
 }
@@ -273,6 +275,11 @@ void test_text(ui::widget& parent)
     BOOST_TEST_EQ(widget.text(), ui::uistring());
 }
 
+void count_edit(int* edits)
+{
+    ++*edits;
+}
+
 void test_text_box(ui::widget& parent)
 {
     {
@@ -284,6 +291,30 @@ void test_text_box(ui::widget& parent)
     test_text<ui::text_box>(parent);
     test_text<ui::password_box>(parent);
     test_text<ui::label>(parent);
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    ui::text_box tb(parent);
+    tb.on_edit(ui::debounce(std::chrono::milliseconds(300), &my_handler));
+    tb.on_edit(ui::throttle(std::chrono::milliseconds(100), &my_handler));
+    tb.text("Edited");
+#endif
+
+    // Wide literals select uistring overloads
+    ui::text_box rope_box(parent);
+    rope_box.text(L"Wide ");
+    rope_box.append_text(L"literal");
+    BOOST_TEST_EQ(rope_box.text(), "Wide literal");
+
+    // Large text is appended at once
+    ui::uitext large;
+    for ( int i = 0; i < 1000; i++ )
+        large += ui::uistring("0123456789");
+
+    int edits = 0;
+    rope_box.on_edit(&count_edit, &edits);
+    rope_box.append_text(large);
+    BOOST_TEST_EQ(edits, 1);
+    BOOST_TEST_EQ(rope_box.text().wstring().size(), 12u + 10000u);
 }
 
 template <class Container>
@@ -463,6 +494,60 @@ void test_notebook(ui::widget& parent)
     BOOST_TEST_EQ(nb.current_page_index(), 1);
 }
 
+// Queued messages are shown by the timer of the next frame
+void wait_frames()
+{
+    ui::event_loop loop;
+    ui::on_timeout(100, boost::bind(&ui::event_loop::exit, &loop));
+    loop.run();
+}
+
+void test_log_view(ui::widget& parent)
+{
+    ui::log_view lv(parent, 100);
+    BOOST_TEST(lv.native_valid());
+    BOOST_TEST_EQ(lv.size(), 0u);
+    BOOST_TEST_EQ(lv.min_level(), BOOST_UI_LOG_LEVEL_TRACE);
+
+    // Appended messages are shown in the next frame
+    lv.append(BOOST_UI_LOG_LEVEL_INFO, "Message");
+    BOOST_TEST_EQ(lv.size(), 0u);
+
+    lv.min_level(BOOST_UI_LOG_LEVEL_WARNING).search("Mess");
+    BOOST_TEST_EQ(lv.min_level(), BOOST_UI_LOG_LEVEL_WARNING);
+    BOOST_TEST_EQ(lv.search(), "Mess");
+    BOOST_TEST_EQ(lv.shown_count(), 0u);
+
+    wait_frames();
+    BOOST_TEST_EQ(lv.size(), 1u);
+    BOOST_TEST_EQ(lv.shown_count(), 0u);
+    lv.min_level(BOOST_UI_LOG_LEVEL_INFO);
+    BOOST_TEST_EQ(lv.shown_count(), 1u);
+    lv.search("Other");
+    BOOST_TEST_EQ(lv.shown_count(), 0u);
+
+    lv.capture();
+    BOOST_UI_LOG_WARNING << "Captured" << 42;
+    lv.capture(false);
+    BOOST_UI_LOG_WARNING << "Not captured";
+
+    wait_frames();
+    BOOST_TEST_EQ(lv.size(), 2u);
+
+    // Captured text follows the location of the call site
+    lv.min_level(BOOST_UI_LOG_LEVEL_TRACE).search("\"Captured\" 42");
+    BOOST_TEST_EQ(lv.shown_count(), 1u);
+    lv.min_level(BOOST_UI_LOG_LEVEL_ERROR);
+    BOOST_TEST_EQ(lv.shown_count(), 0u);
+    lv.min_level(BOOST_UI_LOG_LEVEL_WARNING);
+    BOOST_TEST_EQ(lv.shown_count(), 1u);
+    lv.search("captured");
+    BOOST_TEST_EQ(lv.shown_count(), 0u);
+
+    lv.clear();
+    BOOST_TEST_EQ(lv.size(), 0u);
+}
+
 void test_static_widgets(ui::widget& parent)
 {
     {
@@ -517,6 +602,7 @@ int ui_main()
     test_progress_bar(dlg);
     test_slider(dlg);
     test_notebook(dlg);
+    test_log_view(dlg);
     test_static_widgets(dlg);
 
     BOOST_TEST(!ui::getloc().name().empty());
@@ -0,0 +1,431 @@
+// Copyright (c) 2018 Kolya Kosenko
+
+// Distributed under the Boost Software License, Version 1.0.
+// See http://www.boost.org/LICENSE_1_0.txt
+
+// Converts binary log file that was written by boost::ui::binary_log into text.
+// Usage: log_decode <file>
+// The file should be decoded on the platform where it was written.
+
+#include <boost/ui/log.hpp>
+#include <boost/ui/detail/log_binary.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ui     = boost::ui;
+namespace detail = boost::ui::detail;
+
+namespace {
+
+class reader
+{
+public:
+    reader(const char* begin, const char* end) : m_pos(begin), m_end(end) {}
+
+    bool empty() const { return m_pos == m_end; }
+
+    template <class T>
+    bool read(T& value)
+    {
+        if ( static_cast<std::size_t>(m_end - m_pos) < sizeof value )
+            return false;
+
+        std::memcpy(&value, m_pos, sizeof value);
+        m_pos += sizeof value;
+        return true;
+    }
+
+    template <class Char>
+    bool read_string(std::basic_string<Char>& str, bool& null)
+    {
+        boost::uint32_t length = 0;
+        if ( !read(length) )
+            return false;
+
+        null = length == detail::log_binary_null;
+        if ( null )
+        {
+            str.clear();
+            return true;
+        }
+
+        if ( static_cast<std::size_t>(m_end - m_pos) / sizeof(Char) < length )
+            return false;
+
+        str.resize(length);
+        if ( length )
+            std::memcpy(&str[0], m_pos, length * sizeof(Char));
+        m_pos += length * sizeof(Char);
+        return true;
+    }
+
+    template <class Char>
+    bool read_string(std::basic_string<Char>& str)
+    {
+        bool null = false;
+        return read_string(str, null) && !null;
+    }
+
+private:
+    const char* m_pos;
+    const char* m_end;
+};
+
+struct site
+{
+    bool has_file;
+    std::string file;
+    boost::int32_t line;
+    bool has_function;
+    std::string function;
+};
+
+typedef std::map<boost::uint32_t, site> sites_type;
+
+const char* level_name(int level)
+{
+    switch ( level )
+    {
+        case BOOST_UI_LOG_LEVEL_FATAL:   return "Fatal";
+        case BOOST_UI_LOG_LEVEL_ERROR:   return "Error";
+        case BOOST_UI_LOG_LEVEL_WARNING: return "Warning";
+        case BOOST_UI_LOG_LEVEL_INFO:    return "Info";
+        case BOOST_UI_LOG_LEVEL_VERBOSE: return "Verbose";
+        case BOOST_UI_LOG_LEVEL_DEBUG:   return "Debug";
+        default:                         return "Trace";
+    }
+}
+
+std::string format_time(boost::uint64_t timestamp)
+{
+    const std::time_t seconds = static_cast<std::time_t>(timestamp / 1000000);
+    const unsigned long microseconds = static_cast<unsigned long>(timestamp % 1000000);
+
+    char buffer[64] = "";
+    const std::tm* tm = std::localtime(&seconds);
+    if ( tm )
+        std::strftime(buffer, sizeof buffer, "%Y-%m-%d %H:%M:%S", tm);
+
+    char fraction[16];
+    std::sprintf(fraction, ".%06lu", microseconds);
+
+    return std::string(buffer) + fraction;
+}
+
+bool read_site(reader& r, sites_type& sites)
+{
+    boost::uint32_t id = 0;
+    site s;
+    if ( !r.read(id) || !r.read(s.line) ||
+         !r.read_string(s.file, s.has_file) ||
+         !r.read_string(s.function, s.has_function) )
+        return false;
+
+    s.has_file     = !s.has_file;
+    s.has_function = !s.has_function;
+    sites[id] = s;
+    return true;
+}
+
+// Repeats the same calls of log_string that were recorded
+bool decode_message(reader& r, const sites_type& sites, ui::uistring& str)
+{
+    ui::log_string l(str);
+    while ( !r.empty() )
+    {
+        unsigned char tag = 0;
+        r.read(tag);
+
+        // Zero padding at the end of record
+        if ( tag == 0 )
+            return true;
+
+        l.spaces((tag & detail::log_binary_spaces) != 0)
+         .quotes((tag & detail::log_binary_quotes) != 0);
+
+        switch ( tag & detail::log_binary_tag_mask )
+        {
+            case detail::log_binary_location:
+            {
+                boost::uint32_t id = 0;
+                if ( !r.read(id) )
+                    return false;
+
+                const sites_type::const_iterator iter = sites.find(id);
+                if ( iter == sites.end() )
+                {
+                    l.location("<unknown site>", static_cast<int>(id));
+                    break;
+                }
+
+                const site& s = iter->second;
+                l.location(s.has_file ? s.file.c_str() : NULL, s.line,
+                           s.has_function ? s.function.c_str() : NULL);
+                break;
+            }
+            case detail::log_binary_bool:
+            {
+                boost::uint8_t value = 0;
+                if ( !r.read(value) )
+                    return false;
+                l << (value != 0);
+                break;
+            }
+            case detail::log_binary_signed:
+            {
+                boost::int64_t value = 0;
+                if ( !r.read(value) )
+                    return false;
+                l << static_cast<long long>(value);
+                break;
+            }
+            case detail::log_binary_unsigned:
+            {
+                boost::uint64_t value = 0;
+                if ( !r.read(value) )
+                    return false;
+                l << static_cast<unsigned long long>(value);
+                break;
+            }
+            case detail::log_binary_float:
+            {
+                float value = 0;
+                if ( !r.read(value) )
+                    return false;
+                l << value;
+                break;
+            }
+            case detail::log_binary_double:
+            {
+                double value = 0;
+                if ( !r.read(value) )
+                    return false;
+                l << value;
+                break;
+            }
+            case detail::log_binary_long_double:
+            {
+                long double value = 0;
+                if ( !r.read(value) )
+                    return false;
+                l << value;
+                break;
+            }
+            case detail::log_binary_char:
+            {
+                char value = 0;
+                if ( !r.read(value) )
+                    return false;
+                l << value;
+                break;
+            }
+            case detail::log_binary_wchar:
+            {
+                boost::uint32_t value = 0;
+                if ( !r.read(value) )
+                    return false;
+                l << static_cast<wchar_t>(value);
+                break;
+            }
+            case detail::log_binary_string:
+            {
+                std::string value;
+                if ( !r.read_string(value) )
+                    return false;
+                l << value;
+                break;
+            }
+            case detail::log_binary_wstring:
+            {
+                std::wstring value;
+                if ( !r.read_string(value) )
+                    return false;
+                l << value;
+                break;
+            }
+            case detail::log_binary_raw_string:
+            {
+                std::string value;
+                if ( !r.read_string(value) )
+                    return false;
+                l.raw(ui::uistring(value));
+                break;
+            }
+            case detail::log_binary_raw_wstring:
+            {
+                std::wstring value;
+                if ( !r.read_string(value) )
+                    return false;
+                l.raw(ui::uistring(value));
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+// Checksum rejects bytes of incomplete record that look like header
+bool valid_record(const detail::log_binary_record_header& header,
+                  const char* record, std::size_t available)
+{
+    return header.size >= sizeof header && header.size <= available &&
+           header.size % detail::log_binary_alignment == 0 &&
+           ( header.type == detail::log_binary_site_record ||
+             header.type == detail::log_binary_message_record ) &&
+           header.reserved == 0 &&
+           header.checksum == detail::log_binary_checksum(header,
+               record + sizeof header, header.size - sizeof header);
+}
+
+// Calls f for each complete record, returns false if file is corrupted.
+// Records are reserved concurrently, so record with zero size,
+// which writer didn't complete, can be followed by complete records.
+// Its size is unknown, so next record is searched by alignment steps
+// until the end of the file capacity
+template <class F>
+bool for_each_record(const std::vector<char>& data, std::size_t capacity, F f)
+{
+    const std::size_t header_size = sizeof(detail::log_binary_record_header);
+    const std::size_t end = std::min<std::size_t>(data.size(), capacity);
+
+    std::size_t offset = (sizeof(detail::log_binary_file_header) +
+                          detail::log_binary_alignment - 1) /
+                         detail::log_binary_alignment * detail::log_binary_alignment;
+
+    bool searching = false;
+    while ( offset + header_size <= end )
+    {
+        detail::log_binary_record_header header;
+        std::memcpy(&header, &data[offset], header_size);
+
+        if ( header.size == 0 )
+        {
+            searching = true;
+            offset += detail::log_binary_alignment;
+            continue;
+        }
+
+        if ( !valid_record(header, &data[offset], end - offset) )
+        {
+            if ( !searching )
+                return false;
+
+            // Payload of incomplete record
+            offset += detail::log_binary_alignment;
+            continue;
+        }
+        searching = false;
+
+        const char* begin = &data[offset] + header_size;
+        reader r(begin, &data[offset] + header.size);
+        if ( !f(header, r) )
+            return false;
+
+        offset += header.size;
+    }
+    return true;
+}
+
+class site_collector
+{
+public:
+    explicit site_collector(sites_type& sites) : m_sites(&sites) {}
+
+    bool operator()(const detail::log_binary_record_header& header, reader& r)
+    {
+        return header.type != detail::log_binary_site_record ||
+               read_site(r, *m_sites);
+    }
+
+private:
+    sites_type* m_sites;
+};
+
+class message_printer
+{
+public:
+    explicit message_printer(const sites_type& sites) : m_sites(&sites) {}
+
+    bool operator()(const detail::log_binary_record_header& header, reader& r)
+    {
+        if ( header.type != detail::log_binary_message_record )
+            return true;
+
+        ui::uistring str;
+        const bool valid = decode_message(r, *m_sites, str);
+
+        std::cout << format_time(header.timestamp) << ' '
+                  << level_name(header.level) << ": "
+                  << str.u8string() << '\n';
+
+        return valid;
+    }
+
+private:
+    const sites_type* m_sites;
+};
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    if ( argc != 2 )
+    {
+        std::cerr << "Usage: log_decode <file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream file(argv[1], std::ios_base::in | std::ios_base::binary);
+    if ( !file )
+    {
+        std::cerr << "Unable to open " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+
+    detail::log_binary_file_header header;
+    if ( data.size() < sizeof header )
+    {
+        std::cerr << "File is too small" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::memcpy(&header, &data[0], sizeof header);
+    if ( std::memcmp(header.magic, detail::log_binary_magic, sizeof header.magic) != 0 ||
+         header.version != detail::log_binary_version )
+    {
+        std::cerr << "Unknown file format" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if ( header.wchar_size != sizeof(wchar_t) )
+    {
+        std::cerr << "File was written on other platform" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Site records may follow messages that were written by other threads
+    sites_type sites;
+    for_each_record(data, header.capacity, site_collector(sites));
+
+    if ( !for_each_record(data, header.capacity, message_printer(sites)) )
+    {
+        std::cerr << "File is corrupted" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}